@@ -0,0 +1,1262 @@
+// Measures how expensive glbind.h is to compile. Run this from the "bin" directory, next to glbind_build. The header variants are generated
+// with glbind_build into the "bench" directory, and a minimal translation unit is then compiled against each of them with each compiler.
+// The results are written to a report which can be passed back in with --baseline to find regressions after the registry is updated.
+//
+// With --generator, the build tool itself is measured instead. Synthetic registries are made by repeating the commands, enums, features
+// and extensions of gl.xml, and the time taken by each phase of the build tool is compared between each size of registry.
+//
+// With --init, the time taken by glbInit() is measured instead, with each number of threads for retrieving function pointers. This needs
+// an OpenGL driver and, on Linux, an X server.
+//
+// With --check, nothing is measured. The header is compiled with every value of GLBIND_MAX_GL_VERSION it has a threshold for, each with
+// and without GLBIND_NO_COMPATIBILITY and GLBIND_IMPLEMENTATION, and any warning is an error. The limits that aren't in the core profile
+// are also checked, since querying them on a core profile context is an error.
+//
+// This uses fork() and wait4() to get the peak memory usage of the compiler, so it's only supported on POSIX platforms.
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#if defined(_WIN32)
+#include <direct.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#endif
+
+#define GLB_BENCH_BUILD_PATH    "./glbind_build"
+#define GLB_BENCH_HEADER_DIR    "../.."
+#define GLB_BENCH_OUTPUT_DIR    "bench"
+#define GLB_BENCH_REPORT_PATH   "bench/report.txt"
+#define GLB_BENCH_REGISTRY_PATH "../../resources"
+#define GLB_BENCH_GENERATOR_REPORT_PATH "bench/generator_report.txt"
+#define GLB_BENCH_INIT_REPORT_PATH "bench/init_report.txt"
+
+typedef int glbResult;
+#define GLB_SUCCESS                 0
+#define GLB_ERROR                   -1
+#define GLB_INVALID_ARGS            -2
+#define GLB_FAILED_TO_OPEN_FILE     -5
+#define GLB_NOT_FOUND               -8  /* The compiler could not be run. */
+
+
+// A header variant. Variants with build arguments are generated into their own directory in GLB_BENCH_OUTPUT_DIR.
+struct glbBenchVariant
+{
+    const char* name;
+    const char* buildArgs;      // NULL to use the existing header in GLB_BENCH_HEADER_DIR.
+    bool split;                 // The implementation is output to glbind.c.
+};
+
+static const glbBenchVariant g_Variants[] = {
+    {"full",    NULL,                                                   false},
+    {"trimmed", "--max-version 3.3 --profile core --extensions \"\"",   false},
+    {"split",   "",                                                     true }
+};
+
+// A translation unit to compile. The configurations that define GLBIND_IMPLEMENTATION also measure the cost of the per-command lists in
+// the implementation, such as the name offsets and the global function pointers.
+struct glbBenchConfig
+{
+    const char* name;
+    const char* variant;
+    const char* prologue;       // Inserted before the header is included. NULL to compile the variant's glbind.c instead.
+};
+
+static const glbBenchConfig g_Configs[] = {
+    {"full",                "full",    ""},
+    {"full-impl",           "full",    "#define GLBIND_IMPLEMENTATION\n"},
+    {"pruning-macros",      "full",    "#define GLBIND_MAX_GL_VERSION 330\n#define GLBIND_NO_COMPATIBILITY\n#define GLBIND_ONLY_LISTED_EXTENSIONS\n"},
+    {"pruning-macros-impl", "full",    "#define GLBIND_MAX_GL_VERSION 330\n#define GLBIND_NO_COMPATIBILITY\n#define GLBIND_ONLY_LISTED_EXTENSIONS\n#define GLBIND_IMPLEMENTATION\n"},
+    {"trimmed",             "trimmed", ""},
+    {"trimmed-impl",        "trimmed", "#define GLBIND_IMPLEMENTATION\n"},
+    {"split-header",        "split",   ""},
+    {"split-source",        "split",   NULL}
+};
+
+// The metrics for one configuration with one compiler. Times are the median of each run, and memory is the highest of each run.
+struct glbBenchResult
+{
+    std::string compiler;
+    std::string config;
+    double wallMS = 0;
+    long peakKB = 0;
+    std::map<std::string, double> phasesMS;     // From -ftime-report or --stats, keyed by the name of the phase.
+    std::vector<std::string> phaseNames;        // The phases in the order the build tool outputs them, indented. Only used with --generator.
+};
+
+// The program for --init. It's compiled against the header in GLB_BENCH_HEADER_DIR and outputs the time taken by glbInit(), and by
+// retrieving every function pointer again once the context is current, in the same format as --stats of the build tool.
+static const char* g_InitProgram =
+    "#define _POSIX_C_SOURCE 199309L\n"
+    "#include <stdio.h>\n"
+    "#include <stdlib.h>\n"
+    "#include <time.h>\n"
+    "#define GLBIND_IMPLEMENTATION\n"
+    "#include \"glbind.h\"\n"
+    "\n"
+    "static double glbBenchNowMS(void)\n"
+    "{\n"
+    "    struct timespec t;\n"
+    "    clock_gettime(CLOCK_MONOTONIC, &t);\n"
+    "    return t.tv_sec*1000.0 + t.tv_nsec/1000000.0;\n"
+    "}\n"
+    "\n"
+    "int main(int argc, char** argv)\n"
+    "{\n"
+    "    GLBconfig config = glbConfigInit();\n"
+    "    GLBapi api;\n"
+    "    double beg, init, resolve;\n"
+    "\n"
+    "    config.resolveThreadCount = (argc > 1) ? (GLuint)atoi(argv[1]) : 0;\n"
+    "\n"
+    "    beg = glbBenchNowMS();\n"
+    "    if (glbInit(&api, &config) != GL_NO_ERROR) {\n"
+    "        printf(\"glbInit() failed.\\n\");\n"
+    "        return 1;\n"
+    "    }\n"
+    "    init = glbBenchNowMS();\n"
+    "    glbInitCurrentContextAPI(&api);\n"
+    "    resolve = glbBenchNowMS();\n"
+    "    glbUninit();\n"
+    "\n"
+    "    printf(\"Stats:\\n  glbInit %.3f ms\\n  resolve %.3f ms\\n\", init - beg, resolve - init);\n"
+    "    return 0;\n"
+    "}\n";
+
+// The translation unit for --check. The prologue selects the options being checked. With everything included, this is also linked and run
+// to check that the limits removed from the core profile are flagged in glbind_LimitQueries so that glbQueryLimits() skips them with a
+// core profile context. It returns the number of limits that aren't.
+static const char* g_CheckProgram =
+    "#include \"glbind.h\"\n"
+    "\n"
+    "#if defined(GLBIND_NO_COMPATIBILITY) && (defined(GL_MAX_LIGHTS) || defined(GL_MAX_TEXTURE_UNITS) || defined(GL_MAX_LIST_NESTING))\n"
+    "#error \"Limits removed from the core profile are declared with GLBIND_NO_COMPATIBILITY.\"\n"
+    "#endif\n"
+    "\n"
+    "int main(void)\n"
+    "{\n"
+    "    int errors = 0;\n"
+    "    (void)glClear;\n"
+    "#if defined(GLBIND_IMPLEMENTATION) && !defined(GLBIND_NO_COMPATIBILITY) && !defined(GLBIND_MAX_GL_VERSION)\n"
+    "    static const GLenum removed[] = {\n"
+    "        GL_MAX_LIST_NESTING, GL_MAX_EVAL_ORDER, GL_MAX_LIGHTS, GL_MAX_CLIP_PLANES, GL_MAX_PIXEL_MAP_TABLE, GL_MAX_ATTRIB_STACK_DEPTH,\n"
+    "        GL_MAX_MODELVIEW_STACK_DEPTH, GL_MAX_NAME_STACK_DEPTH, GL_MAX_PROJECTION_STACK_DEPTH, GL_MAX_TEXTURE_STACK_DEPTH,\n"
+    "        GL_MAX_CLIENT_ATTRIB_STACK_DEPTH, GL_MAX_TEXTURE_UNITS, GL_MAX_TEXTURE_COORDS\n"
+    "    };\n"
+    "    size_t iRemoved;\n"
+    "    for (iRemoved = 0; iRemoved < sizeof(removed)/sizeof(removed[0]); ++iRemoved) {\n"
+    "        const glbind_LimitQuery* pQuery;\n"
+    "        for (pQuery = glbind_LimitQueries; pQuery->pname != 0 && pQuery->pname != removed[iRemoved]; ++pQuery) {\n"
+    "        }\n"
+    "        if (pQuery->pname != 0 && (pQuery->flags & GLBIND_LIMIT_FLAG_COMPATIBILITY) == 0) {\n"
+    "            printf(\"0x%04X is removed from the core profile but isn't flagged.\\n\", removed[iRemoved]);\n"
+    "            errors += 1;\n"
+    "        }\n"
+    "    }\n"
+    "#endif\n"
+    "    return errors;\n"
+    "}\n";
+
+// Parses the time taken by each phase from the output of a run.
+typedef void (* glbBenchParsePhasesProc)(const char* filePath, std::map<std::string, double> &phasesMS);
+
+
+glbResult glbBenchWriteTextFile(const std::string &filePath, const std::string &text)
+{
+    FILE* pFile = fopen(filePath.c_str(), "wb");
+    if (pFile == NULL) {
+        return GLB_FAILED_TO_OPEN_FILE;
+    }
+
+    fwrite(text.c_str(), 1, text.size(), pFile);
+    fclose(pFile);
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBenchReadTextFile(const std::string &filePath, std::string &textOut)
+{
+    FILE* pFile = fopen(filePath.c_str(), "rb");
+    if (pFile == NULL) {
+        return GLB_FAILED_TO_OPEN_FILE;
+    }
+
+    char buffer[4096];
+    textOut.clear();
+    for (size_t bytesRead = fread(buffer, 1, sizeof(buffer), pFile); bytesRead > 0; bytesRead = fread(buffer, 1, sizeof(buffer), pFile)) {
+        textOut.append(buffer, bytesRead);
+    }
+
+    fclose(pFile);
+    return GLB_SUCCESS;
+}
+
+std::vector<std::string> glbBenchReadLines(const char* filePath)
+{
+    std::vector<std::string> lines;
+
+    FILE* pFile = fopen(filePath, "rb");
+    if (pFile == NULL) {
+        return lines;
+    }
+
+    std::string line;
+    for (int c = fgetc(pFile); c != EOF; c = fgetc(pFile)) {
+        if (c == '\n') {
+            lines.push_back(line);
+            line.clear();
+        } else if (c != '\r') {
+            line += (char)c;
+        }
+    }
+
+    if (!line.empty()) {
+        lines.push_back(line);
+    }
+
+    fclose(pFile);
+    return lines;
+}
+
+std::string glbBenchTrim(const std::string &s)
+{
+    size_t beg = s.find_first_not_of(" \t");
+    size_t end = s.find_last_not_of(" \t");
+    return (beg == std::string::npos) ? std::string() : s.substr(beg, end - beg + 1);
+}
+
+std::vector<std::string> glbBenchSplit(const std::string &s, char separator)
+{
+    std::vector<std::string> items;
+    size_t beg = 0;
+    for (;;) {
+        size_t end = s.find(separator, beg);
+        items.push_back(s.substr(beg, (end == std::string::npos) ? std::string::npos : end - beg));
+        if (end == std::string::npos) {
+            break;
+        }
+
+        beg = end + 1;
+    }
+
+    return items;
+}
+
+void glbBenchMakeDirectory(const char* path)
+{
+#if defined(_WIN32)
+    _mkdir(path);
+#else
+    mkdir(path, 0755);
+#endif
+}
+
+double glbBenchMedian(std::vector<double> values)
+{
+    if (values.empty()) {
+        return 0;
+    }
+
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+
+// Runs a program and waits for it to finish. Standard error is redirected to stderrPath so the time report can be parsed.
+glbResult glbBenchRun(const std::vector<std::string> &args, const char* stderrPath, double* pWallMS, long* pPeakKB)
+{
+#if defined(_WIN32)
+    (void)args; (void)stderrPath; (void)pWallMS; (void)pPeakKB;
+    printf("The compile benchmark is only supported on POSIX platforms.\n");
+    return GLB_ERROR;
+#else
+    std::vector<char*> argv;
+    for (size_t iArg = 0; iArg < args.size(); ++iArg) {
+        argv.push_back(const_cast<char*>(args[iArg].c_str()));
+    }
+    argv.push_back(NULL);
+
+    std::chrono::steady_clock::time_point beg = std::chrono::steady_clock::now();
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        return GLB_ERROR;
+    }
+
+    if (pid == 0) {
+        int fd = open(stderrPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0) {
+            dup2(fd, STDERR_FILENO);
+            dup2(fd, STDOUT_FILENO);
+            close(fd);
+        }
+
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) != pid) {
+        return GLB_ERROR;
+    }
+
+    *pWallMS = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - beg).count();
+    *pPeakKB = usage.ru_maxrss;     // Kilobytes on Linux and the BSDs, but bytes on macOS.
+#if defined(__APPLE__)
+    *pPeakKB /= 1024;
+#endif
+
+    if (!WIFEXITED(status)) {
+        return GLB_ERROR;
+    }
+
+    if (WEXITSTATUS(status) == 127) {
+        return GLB_NOT_FOUND;
+    }
+
+    return (WEXITSTATUS(status) == 0) ? GLB_SUCCESS : GLB_ERROR;
+#endif
+}
+
+// The rows of GCC's time report that belong to the front end. The rest are for code generation, which doesn't depend on the header.
+static const char* g_GCCFrontEndPhases[] = {
+    "phase setup",
+    "phase parsing",
+    "phase lang. deferred",
+    "preprocessing",
+    "lexical analysis",
+    "parser",
+    "name lookup",
+    "TOTAL"
+};
+
+bool glbBenchIsGCCFrontEndPhase(const std::string &name)
+{
+    for (size_t iPhase = 0; iPhase < sizeof(g_GCCFrontEndPhases)/sizeof(g_GCCFrontEndPhases[0]); ++iPhase) {
+        if (name.compare(0, strlen(g_GCCFrontEndPhases[iPhase]), g_GCCFrontEndPhases[iPhase]) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Parses the wall times of the front-end phases out of the output of -ftime-report. GCC outputs one table with the name of each phase
+// followed by a colon, and the user, system and wall times after it. Clang outputs several tables, each with a title and a header line
+// naming each column, and the name of each row at the end. Only the table titled "Clang front-end time report" is used.
+void glbBenchParseTimeReport(const char* filePath, std::map<std::string, double> &phasesMS)
+{
+    std::vector<std::string> lines = glbBenchReadLines(filePath);
+    int clangWallColumn = -1;
+    bool isClangFrontEnd = false;
+
+    for (size_t iLine = 0; iLine < lines.size(); ++iLine) {
+        const std::string &line = lines[iLine];
+
+        // Clang's table titles are between two lines of "===---...".
+        if (line.compare(0, 3, "===") == 0) {
+            if (iLine >= 2 && lines[iLine - 2].compare(0, 3, "===") == 0) {
+                isClangFrontEnd = lines[iLine - 1].find("front-end") != std::string::npos;
+                clangWallColumn = -1;
+            }
+            continue;
+        }
+
+        if (line.find("Wall Time") != std::string::npos) {
+            size_t wallPos = line.find("Wall Time");
+            clangWallColumn = 0;
+            if (line.find("User Time")   < wallPos) clangWallColumn += 1;
+            if (line.find("System Time") < wallPos) clangWallColumn += 1;
+            if (line.find("User+System") < wallPos) clangWallColumn += 1;
+            continue;
+        }
+
+        // The numbers in each row are followed by a percentage in brackets which is skipped.
+        std::vector<double> values;
+        std::string name;
+        size_t colon = line.find(" : ");
+        const char* p;
+        if (colon != std::string::npos) {
+            name = glbBenchTrim(line.substr(0, colon));
+            p = line.c_str() + colon + 3;
+        } else if (clangWallColumn >= 0 && isClangFrontEnd) {
+            p = line.c_str();
+        } else {
+            continue;
+        }
+
+        for (;;) {
+            while (*p == ' ') p += 1;
+            if (*p == '(') {
+                const char* pEnd = strchr(p, ')');
+                if (pEnd == NULL) break;
+                p = pEnd + 1;
+                continue;
+            }
+
+            char* pEnd;
+            double value = strtod(p, &pEnd);
+            if (pEnd == p) {
+                break;
+            }
+
+            values.push_back(value);
+            p = pEnd;
+        }
+
+        if (colon == std::string::npos) {
+            name = glbBenchTrim(p);
+            if (name.empty() || (int)values.size() <= clangWallColumn) {
+                continue;
+            }
+
+            phasesMS[name] = values[clangWallColumn] * 1000;
+        } else {
+            if (values.size() < 3 || !glbBenchIsGCCFrontEndPhase(name)) {
+                continue;
+            }
+
+            phasesMS[name] = values[2] * 1000;
+        }
+    }
+}
+
+
+glbResult glbBenchGenerateVariants(const std::string &buildPath, std::map<std::string, std::string> &includeDirs)
+{
+    glbBenchMakeDirectory(GLB_BENCH_OUTPUT_DIR);
+
+    for (size_t iVariant = 0; iVariant < sizeof(g_Variants)/sizeof(g_Variants[0]); ++iVariant) {
+        const glbBenchVariant &variant = g_Variants[iVariant];
+        if (variant.buildArgs == NULL) {
+            includeDirs[variant.name] = GLB_BENCH_HEADER_DIR;
+            continue;
+        }
+
+        std::string dir = std::string(GLB_BENCH_OUTPUT_DIR) + "/" + variant.name;
+        glbBenchMakeDirectory(dir.c_str());
+
+        std::string command = buildPath + " --no-cache --output " + dir + "/glbind.h " + variant.buildArgs;
+        if (variant.split) {
+            command += " --source " + dir + "/glbind.c";
+        }
+        command += " > /dev/null";
+
+        printf("Generating %s: %s\n", variant.name, command.c_str());
+        if (system(command.c_str()) != 0) {
+            printf("Failed to generate the %s variant.\n", variant.name);
+            return GLB_ERROR;
+        }
+
+        includeDirs[variant.name] = dir;
+    }
+
+    return GLB_SUCCESS;
+}
+
+// Runs a program a number of times and takes the median of the wall time and of each phase, and the highest peak memory usage.
+glbResult glbBenchMeasure(const std::vector<std::string> &args, const std::string &stderrPath, int runs, glbBenchParsePhasesProc parsePhases, glbBenchResult &result)
+{
+    std::vector<double> wallMS;
+    std::map<std::string, std::vector<double>> phasesMS;
+    for (int iRun = 0; iRun < runs; ++iRun) {
+        double runWallMS;
+        long runPeakKB;
+        glbResult runResult = glbBenchRun(args, stderrPath.c_str(), &runWallMS, &runPeakKB);
+        if (runResult != GLB_SUCCESS) {
+            return runResult;
+        }
+
+        wallMS.push_back(runWallMS);
+        result.peakKB = std::max(result.peakKB, runPeakKB);
+
+        // Phases that don't show up in a run took no time.
+        std::map<std::string, double> runPhasesMS;
+        parsePhases(stderrPath.c_str(), runPhasesMS);
+        for (std::map<std::string, double>::const_iterator it = runPhasesMS.begin(); it != runPhasesMS.end(); ++it) {
+            phasesMS[it->first].resize(iRun, 0);
+            phasesMS[it->first].push_back(it->second);
+        }
+    }
+
+    result.wallMS = glbBenchMedian(wallMS);
+    for (std::map<std::string, std::vector<double>>::iterator it = phasesMS.begin(); it != phasesMS.end(); ++it) {
+        it->second.resize(runs, 0);
+        result.phasesMS[it->first] = glbBenchMedian(it->second);
+    }
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBenchCompile(const std::string &compiler, const glbBenchConfig &config, const std::string &includeDir, int runs, glbBenchResult &result)
+{
+    std::string sourcePath;
+    if (config.prologue == NULL) {
+        sourcePath = includeDir + "/glbind.c";
+    } else {
+        sourcePath = std::string(GLB_BENCH_OUTPUT_DIR) + "/" + config.name + ".c";
+        glbResult writeResult = glbBenchWriteTextFile(sourcePath, std::string(config.prologue) + "#include \"glbind.h\"\n\nint glbBench(void)\n{\n    return glClear != NULL;\n}\n");
+        if (writeResult != GLB_SUCCESS) {
+            return writeResult;
+        }
+    }
+
+    std::vector<std::string> args;
+    args.push_back(compiler);
+    args.push_back("-std=c99");
+    args.push_back("-O0");
+    args.push_back("-w");
+    args.push_back("-ftime-report");
+    args.push_back("-I" + includeDir);
+    args.push_back("-c");
+    args.push_back(sourcePath);
+    args.push_back("-o");
+    args.push_back(std::string(GLB_BENCH_OUTPUT_DIR) + "/bench.o");
+
+    glbResult measureResult = glbBenchMeasure(args, std::string(GLB_BENCH_OUTPUT_DIR) + "/time-report.txt", runs, glbBenchParseTimeReport, result);
+    if (measureResult != GLB_SUCCESS) {
+        return measureResult;
+    }
+
+    result.compiler = compiler;
+    result.config   = config.name;
+
+    return GLB_SUCCESS;
+}
+
+// Makes a registry that's a number of times the size of gl.xml. The first copy is gl.xml as is. Each copy after that repeats everything
+// except the types and groups, with "_x<copy>" appended to the name of each command, enum, feature and extension. wgl.xml and glx.xml
+// are copied as is.
+glbResult glbBenchMakeScaledRegistry(const std::string &sourceDir, const std::string &destDir, int scale)
+{
+    const char* unscaledFiles[2] = {"wgl.xml", "glx.xml"};
+    for (int iFile = 0; iFile < 2; ++iFile) {
+        std::string text;
+        glbResult result = glbBenchReadTextFile(sourceDir + "/" + unscaledFiles[iFile], text);
+        if (result != GLB_SUCCESS) {
+            return result;
+        }
+
+        result = glbBenchWriteTextFile(destDir + "/" + unscaledFiles[iFile], text);
+        if (result != GLB_SUCCESS) {
+            return result;
+        }
+    }
+
+    std::string gl;
+    glbResult result = glbBenchReadTextFile(sourceDir + "/gl.xml", gl);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    size_t bodyBeg = gl.find("<registry>");
+    size_t bodyEnd = gl.rfind("</registry>");
+    if (bodyBeg == std::string::npos || bodyEnd == std::string::npos) {
+        printf("%s/gl.xml is not a registry.\n", sourceDir.c_str());
+        return GLB_ERROR;
+    }
+    bodyBeg += strlen("<registry>");
+
+    // Types and groups are shared by every copy so they're only output once.
+    std::string body = gl.substr(bodyBeg, bodyEnd - bodyBeg);
+    const char* sharedElements[2] = {"types", "groups"};
+    for (int iElement = 0; iElement < 2; ++iElement) {
+        std::string openTag  = std::string("<")  + sharedElements[iElement] + ">";
+        std::string closeTag = std::string("</") + sharedElements[iElement] + ">";
+        size_t beg = body.find(openTag);
+        size_t end = body.find(closeTag, beg);
+        if (beg != std::string::npos && end != std::string::npos) {
+            body.erase(beg, end + closeTag.size() - beg);
+        }
+    }
+
+    std::string scaled = gl.substr(0, bodyEnd);
+    for (int iCopy = 1; iCopy < scale; ++iCopy) {
+        char suffix[32];
+        snprintf(suffix, sizeof(suffix), "_x%d", iCopy);
+
+        // The next occurrence of each prefix is only searched for again once it's been passed.
+        const char* prefixes[4] = {"<name>gl", "<name>GL_", "name=\"gl", "name=\"GL_"};
+        size_t found[4] = {0, 0, 0, 0};
+        size_t pos = 0;
+        for (int iPrefix = 0; iPrefix < 4; ++iPrefix) {
+            found[iPrefix] = body.find(prefixes[iPrefix]);
+        }
+
+        for (;;) {
+            size_t next = std::string::npos;
+            size_t nextLength = 0;
+            for (int iPrefix = 0; iPrefix < 4; ++iPrefix) {
+                if (found[iPrefix] < pos) {
+                    found[iPrefix] = body.find(prefixes[iPrefix], pos);
+                }
+                if (found[iPrefix] < next) {
+                    next = found[iPrefix];
+                    nextLength = strlen(prefixes[iPrefix]);
+                }
+            }
+
+            size_t nameEnd = (next == std::string::npos) ? body.size() : next + nextLength;
+            while (nameEnd < body.size() && (isalnum((unsigned char)body[nameEnd]) || body[nameEnd] == '_')) {
+                nameEnd += 1;
+            }
+
+            scaled.append(body, pos, nameEnd - pos);
+            if (next == std::string::npos) {
+                break;
+            }
+
+            // References to types are left alone since the types aren't repeated.
+            size_t elementBeg = body.rfind('<', next);
+            if (body.compare(elementBeg, 6, "<type ") != 0) {
+                scaled.append(suffix);
+            }
+
+            pos = nameEnd;
+        }
+    }
+    scaled.append(gl, bodyEnd, std::string::npos);
+
+    return glbBenchWriteTextFile(destDir + "/gl.xml", scaled);
+}
+
+// Parses the name and time of each phase from the output of the build tool with --stats. The phases are listed after "Stats:", one per
+// line, with the time in milliseconds at the end. Nested phases are indented, and the indentation is kept in the name.
+void glbBenchParseStatsInOrder(const char* filePath, std::vector<std::pair<std::string, double>> &phasesMS)
+{
+    std::vector<std::string> lines = glbBenchReadLines(filePath);
+    bool isStats = false;
+
+    for (size_t iLine = 0; iLine < lines.size(); ++iLine) {
+        const std::string &line = lines[iLine];
+        if (line == "Stats:") {
+            isStats = true;
+            continue;
+        }
+
+        size_t unitPos = line.rfind(" ms");
+        if (!isStats || unitPos == std::string::npos || unitPos == 0) {
+            continue;
+        }
+
+        size_t valuePos = line.find_last_of(' ', unitPos - 1);
+        if (valuePos == std::string::npos) {
+            continue;
+        }
+
+        std::string name = line.substr(0, valuePos);
+        name = name.substr(0, name.find_last_not_of(' ') + 1);
+        name = name.substr(std::min(name.size(), (size_t)2));
+
+        phasesMS.push_back(std::make_pair(name, atof(line.c_str() + valuePos + 1)));
+    }
+}
+
+void glbBenchParseStats(const char* filePath, std::map<std::string, double> &phasesMS)
+{
+    std::vector<std::pair<std::string, double>> phasesInOrder;
+    glbBenchParseStatsInOrder(filePath, phasesInOrder);
+    for (size_t iPhase = 0; iPhase < phasesInOrder.size(); ++iPhase) {
+        phasesMS[glbBenchTrim(phasesInOrder[iPhase].first)] = phasesInOrder[iPhase].second;
+    }
+}
+
+glbResult glbBenchGenerator(const std::string &buildPath, const std::string &registryDir, int scale, int runs, glbBenchResult &result)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%dx", scale);
+
+    std::string dir = std::string(GLB_BENCH_OUTPUT_DIR) + "/registry_" + name;
+    glbBenchMakeDirectory(dir.c_str());
+
+    glbResult makeResult = glbBenchMakeScaledRegistry(registryDir, dir, scale);
+    if (makeResult != GLB_SUCCESS) {
+        printf("Failed to make the %s registry from %s.\n", name, registryDir.c_str());
+        return makeResult;
+    }
+
+    std::vector<std::string> args;
+    args.push_back(buildPath);
+    args.push_back("--no-cache");
+    args.push_back("--stats");
+    args.push_back("--registry");
+    args.push_back(dir);
+    args.push_back("--output");
+    args.push_back(dir + "/glbind.h");
+
+    glbResult measureResult = glbBenchMeasure(args, dir + "/stats.txt", runs, glbBenchParseStats, result);
+    if (measureResult != GLB_SUCCESS) {
+        return measureResult;
+    }
+
+    std::vector<std::pair<std::string, double>> phasesInOrder;
+    glbBenchParseStatsInOrder((dir + "/stats.txt").c_str(), phasesInOrder);
+    for (size_t iPhase = 0; iPhase < phasesInOrder.size(); ++iPhase) {
+        result.phaseNames.push_back(phasesInOrder[iPhase].first);
+    }
+
+    result.compiler = "generator";
+    result.config   = name;
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBenchInit(int threadCount, int runs, glbBenchResult &result)
+{
+    char count[16];
+    snprintf(count, sizeof(count), "%d", threadCount);
+
+    std::vector<std::string> args;
+    args.push_back(std::string("./") + GLB_BENCH_OUTPUT_DIR + "/init");
+    args.push_back(count);
+
+    glbResult measureResult = glbBenchMeasure(args, std::string(GLB_BENCH_OUTPUT_DIR) + "/init.txt", runs, glbBenchParseStats, result);
+    if (measureResult != GLB_SUCCESS) {
+        return measureResult;
+    }
+
+    result.compiler = "init";
+    result.config   = std::string("threads-") + count;
+
+    return GLB_SUCCESS;
+}
+
+// Outputs a table with the time taken by each phase at each scale. The last column is how much the time grew relative to the registry,
+// so anything that scales linearly is 1.0 and anything that's superlinear is more than that.
+void glbBenchPrintGeneratorTable(const std::vector<glbBenchResult> &results)
+{
+    if (results.empty()) {
+        return;
+    }
+
+    const glbBenchResult &first = results.front();
+    const glbBenchResult &last  = results.back();
+    double registryGrowth = atof(last.config.c_str()) / atof(first.config.c_str());
+
+    printf("\n%-40s", "phase (ms)");
+    for (size_t iResult = 0; iResult < results.size(); ++iResult) {
+        printf(" %10s", results[iResult].config.c_str());
+    }
+    printf(" %10s\n", "growth");
+
+    // The wall time and peak memory are measured by the benchmark rather than being output by the build tool.
+    std::vector<std::string> rows = last.phaseNames;
+    rows.push_back("wall");
+    rows.push_back("peak memory (MB)");
+
+    for (size_t iRow = 0; iRow < rows.size(); ++iRow) {
+        printf("%-40s", rows[iRow].c_str());
+
+        double firstValue = 0;
+        double lastValue  = 0;
+        for (size_t iResult = 0; iResult < results.size(); ++iResult) {
+            double value;
+            if (iRow == rows.size() - 2) {
+                value = results[iResult].wallMS;
+            } else if (iRow == rows.size() - 1) {
+                value = results[iResult].peakKB / 1024.0;
+            } else {
+                std::map<std::string, double>::const_iterator it = results[iResult].phasesMS.find(glbBenchTrim(rows[iRow]));
+                value = (it == results[iResult].phasesMS.end()) ? 0 : it->second;
+            }
+
+            if (iResult == 0) {
+                firstValue = value;
+            }
+            lastValue = value;
+
+            printf(" %10.1f", value);
+        }
+
+        if (firstValue > 0 && results.size() > 1) {
+            printf(" %10.2f", (lastValue / firstValue) / registryGrowth);
+        }
+        printf("\n");
+    }
+}
+
+
+// The report has one tab separated line per metric so that it's easy to diff and to read back in as a baseline.
+std::string glbBenchFormatReport(const char* title, const std::vector<glbBenchResult> &results, int runs)
+{
+    std::string report;
+    char line[1024];
+
+    snprintf(line, sizeof(line), "# %s. Median of %d runs, except peak memory which is the highest.\n", title, runs);
+    report += line;
+    report += "# compiler\tconfig\tmetric\tvalue\n";
+
+    for (size_t iResult = 0; iResult < results.size(); ++iResult) {
+        const glbBenchResult &result = results[iResult];
+
+        snprintf(line, sizeof(line), "%s\t%s\twall_ms\t%.1f\n", result.compiler.c_str(), result.config.c_str(), result.wallMS);
+        report += line;
+        snprintf(line, sizeof(line), "%s\t%s\tpeak_kb\t%ld\n", result.compiler.c_str(), result.config.c_str(), result.peakKB);
+        report += line;
+
+        for (std::map<std::string, double>::const_iterator it = result.phasesMS.begin(); it != result.phasesMS.end(); ++it) {
+            snprintf(line, sizeof(line), "%s\t%s\tphase_ms:%s\t%.1f\n", result.compiler.c_str(), result.config.c_str(), it->first.c_str(), it->second);
+            report += line;
+        }
+    }
+
+    return report;
+}
+
+glbResult glbBenchLoadReport(const char* filePath, std::map<std::string, double> &metrics)
+{
+    std::vector<std::string> lines = glbBenchReadLines(filePath);
+    if (lines.empty()) {
+        return GLB_FAILED_TO_OPEN_FILE;
+    }
+
+    for (size_t iLine = 0; iLine < lines.size(); ++iLine) {
+        if (lines[iLine].empty() || lines[iLine][0] == '#') {
+            continue;
+        }
+
+        std::vector<std::string> columns = glbBenchSplit(lines[iLine], '\t');
+        if (columns.size() == 4) {
+            metrics[columns[0] + "\t" + columns[1] + "\t" + columns[2]] = atof(columns[3].c_str());
+        }
+    }
+
+    return GLB_SUCCESS;
+}
+
+// Compares wall time and peak memory against a previous report. Returns the number of regressions over the threshold. Front-end phases are
+// too noisy to check on their own, but they're in the report to help explain a regression.
+int glbBenchCompare(const std::vector<glbBenchResult> &results, const std::map<std::string, double> &baseline, double thresholdPercent)
+{
+    int regressionCount = 0;
+
+    printf("\n%-8s %-20s %-8s %12s %12s %8s\n", "compiler", "config", "metric", "baseline", "current", "change");
+    for (size_t iResult = 0; iResult < results.size(); ++iResult) {
+        const glbBenchResult &result = results[iResult];
+        const char* metricNames[2] = {"wall_ms", "peak_kb"};
+        double      current[2]     = {result.wallMS, (double)result.peakKB};
+
+        for (int iMetric = 0; iMetric < 2; ++iMetric) {
+            std::map<std::string, double>::const_iterator it = baseline.find(result.compiler + "\t" + result.config + "\t" + metricNames[iMetric]);
+            if (it == baseline.end() || it->second <= 0) {
+                continue;
+            }
+
+            double changePercent = (current[iMetric] - it->second) / it->second * 100;
+            bool isRegression = changePercent > thresholdPercent;
+            if (isRegression) {
+                regressionCount += 1;
+            }
+
+            printf("%-8s %-20s %-8s %12.1f %12.1f %+7.1f%%%s\n", result.compiler.c_str(), result.config.c_str(), metricNames[iMetric], it->second, current[iMetric], changePercent, isRegression ? "  REGRESSION" : "");
+        }
+    }
+
+    return regressionCount;
+}
+
+
+// Retrieves every version the header can be limited to with GLBIND_MAX_GL_VERSION, in ascending order.
+glbResult glbBenchGetVersionThresholds(const std::string &headerPath, std::vector<int> &versions)
+{
+    std::string text;
+    glbResult result = glbBenchReadTextFile(headerPath, text);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    const char* prefix = "GLBIND_MAX_GL_VERSION >= ";
+    for (size_t pos = text.find(prefix); pos != std::string::npos; pos = text.find(prefix, pos + 1)) {
+        int version = atoi(text.c_str() + pos + strlen(prefix));
+        if (version > 0 && std::find(versions.begin(), versions.end(), version) == versions.end()) {
+            versions.push_back(version);
+        }
+    }
+
+    std::sort(versions.begin(), versions.end());
+    return GLB_SUCCESS;
+}
+
+void glbBenchPrintUsage()
+{
+    printf("Usage: glbind_bench [options]\n");
+    printf("\n");
+    printf("Compile time of glbind.h. This is the default.\n");
+    printf("  --cc <list>            Comma separated list of compilers. Compilers that can't be run are skipped. Defaults to gcc,clang.\n");
+    printf("\n");
+    printf("Build tool.\n");
+    printf("  --generator            Measure each phase of the build tool with synthetic registries instead.\n");
+    printf("  --scales <list>        Comma separated list of registry sizes, relative to gl.xml. Defaults to 1,4,16.\n");
+    printf("  --registry <dir>       Directory containing the gl.xml, wgl.xml and glx.xml to scale. Defaults to %s.\n", GLB_BENCH_REGISTRY_PATH);
+    printf("\n");
+    printf("Initialization.\n");
+    printf("  --init                 Measure glbInit() with the header in %s instead. Compiled with the first of --cc.\n", GLB_BENCH_HEADER_DIR);
+    printf("  --threads <list>       Comma separated list of thread counts for retrieving function pointers. Defaults to 1,2,4,8.\n");
+    printf("\n");
+    printf("Checking.\n");
+    printf("  --check                Compile the header in %s with every GLBIND_MAX_GL_VERSION, each with and without\n", GLB_BENCH_HEADER_DIR);
+    printf("                         GLBIND_NO_COMPATIBILITY and GLBIND_IMPLEMENTATION, with each of --cc. Nothing is measured.\n");
+    printf("\n");
+    printf("Common.\n");
+    printf("  --runs <count>         Number of times each measurement is taken. Defaults to 5.\n");
+    printf("  --build <file>         The build tool. Defaults to %s.\n", GLB_BENCH_BUILD_PATH);
+    printf("  --output <file>        Where to write the report. Defaults to %s, %s with --generator or %s with --init.\n", GLB_BENCH_REPORT_PATH, GLB_BENCH_GENERATOR_REPORT_PATH, GLB_BENCH_INIT_REPORT_PATH);
+    printf("  --baseline <file>      A previous report to compare against. Exits with an error if anything regressed.\n");
+    printf("  --threshold <percent>  How much wall time or peak memory can increase before it's a regression. Defaults to 10.\n");
+    printf("  --help                 Show this message.\n");
+}
+
+glbResult glbBenchCompileAll(const std::vector<std::string> &compilers, const std::string &buildPath, int runs, std::vector<glbBenchResult> &results)
+{
+    std::map<std::string, std::string> includeDirs;
+    glbResult result = glbBenchGenerateVariants(buildPath, includeDirs);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    printf("\n%-8s %-20s %10s %10s %10s\n", "compiler", "config", "wall ms", "peak MB", "parse ms");
+    for (size_t iCompiler = 0; iCompiler < compilers.size(); ++iCompiler) {
+        for (size_t iConfig = 0; iConfig < sizeof(g_Configs)/sizeof(g_Configs[0]); ++iConfig) {
+            const glbBenchConfig &config = g_Configs[iConfig];
+
+            glbBenchResult configResult;
+            result = glbBenchCompile(compilers[iCompiler], config, includeDirs[config.variant], runs, configResult);
+            if (result == GLB_NOT_FOUND) {
+                printf("%-8s not found, skipping.\n", compilers[iCompiler].c_str());
+                break;
+            }
+            if (result != GLB_SUCCESS) {
+                printf("%-8s %-20s failed to compile. See %s/time-report.txt.\n", compilers[iCompiler].c_str(), config.name, GLB_BENCH_OUTPUT_DIR);
+                return result;
+            }
+
+            // The front-end time is called "phase parsing" by GCC and "Clang front-end timer" by Clang.
+            double parseMS = configResult.phasesMS.count("phase parsing") ? configResult.phasesMS["phase parsing"] : configResult.phasesMS["Clang front-end timer"];
+            printf("%-8s %-20s %10.1f %10.1f %10.1f\n", configResult.compiler.c_str(), configResult.config.c_str(), configResult.wallMS, configResult.peakKB / 1024.0, parseMS);
+
+            results.push_back(configResult);
+        }
+    }
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBenchGeneratorAll(const std::vector<std::string> &scales, const std::string &buildPath, const std::string &registryDir, int runs, std::vector<glbBenchResult> &results)
+{
+    glbBenchMakeDirectory(GLB_BENCH_OUTPUT_DIR);
+
+    for (size_t iScale = 0; iScale < scales.size(); ++iScale) {
+        int scale = atoi(scales[iScale].c_str());
+        if (scale < 1) {
+            printf("Invalid scale: %s\n", scales[iScale].c_str());
+            return GLB_INVALID_ARGS;
+        }
+
+        printf("Running the build tool with the %dx registry.\n", scale);
+
+        glbBenchResult scaleResult;
+        glbResult result = glbBenchGenerator(buildPath, registryDir, scale, runs, scaleResult);
+        if (result != GLB_SUCCESS) {
+            printf("The build tool failed with the %dx registry.\n", scale);
+            return result;
+        }
+
+        results.push_back(scaleResult);
+    }
+
+    glbBenchPrintGeneratorTable(results);
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBenchInitAll(const std::string &compiler, const std::vector<std::string> &threadCounts, int runs, std::vector<glbBenchResult> &results)
+{
+    glbBenchMakeDirectory(GLB_BENCH_OUTPUT_DIR);
+
+    std::string sourcePath = std::string(GLB_BENCH_OUTPUT_DIR) + "/init.c";
+    glbResult result = glbBenchWriteTextFile(sourcePath, g_InitProgram);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    std::vector<std::string> args;
+    args.push_back(compiler);
+    args.push_back("-std=c99");
+    args.push_back("-O2");
+    args.push_back("-w");
+    args.push_back(std::string("-I") + GLB_BENCH_HEADER_DIR);
+    args.push_back(sourcePath);
+    args.push_back("-o");
+    args.push_back(std::string(GLB_BENCH_OUTPUT_DIR) + "/init");
+    args.push_back("-ldl");
+    args.push_back("-lpthread");
+
+    double wallMS;
+    long peakKB;
+    result = glbBenchRun(args, (std::string(GLB_BENCH_OUTPUT_DIR) + "/init.txt").c_str(), &wallMS, &peakKB);
+    if (result != GLB_SUCCESS) {
+        printf("Failed to compile %s with %s. See %s/init.txt.\n", sourcePath.c_str(), compiler.c_str(), GLB_BENCH_OUTPUT_DIR);
+        return result;
+    }
+
+    printf("\n%-12s %12s %12s %10s\n", "config", "glbInit ms", "resolve ms", "speedup");
+    for (size_t iThreadCount = 0; iThreadCount < threadCounts.size(); ++iThreadCount) {
+        int threadCount = atoi(threadCounts[iThreadCount].c_str());
+        if (threadCount < 1) {
+            printf("Invalid thread count: %s\n", threadCounts[iThreadCount].c_str());
+            return GLB_INVALID_ARGS;
+        }
+
+        glbBenchResult threadCountResult;
+        result = glbBenchInit(threadCount, runs, threadCountResult);
+        if (result != GLB_SUCCESS) {
+            printf("glbInit() failed with %d thread(s). See %s/init.txt.\n", threadCount, GLB_BENCH_OUTPUT_DIR);
+            return result;
+        }
+
+        // The speedup is of retrieving function pointers, relative to the first thread count.
+        double resolveMS = threadCountResult.phasesMS["resolve"];
+        double firstResolveMS = results.empty() ? resolveMS : results.front().phasesMS["resolve"];
+        printf("%-12s %12.3f %12.3f %10.2f\n", threadCountResult.config.c_str(), threadCountResult.phasesMS["glbInit"], resolveMS, (resolveMS > 0) ? firstResolveMS / resolveMS : 0);
+
+        results.push_back(threadCountResult);
+    }
+
+    return GLB_SUCCESS;
+}
+
+// Compiles g_CheckProgram once for each combination of options. Every combination is tried, even after a failure, and the output of
+// each failure is left in the output directory. Returns the number of failures in *pFailureCount.
+glbResult glbBenchCheckAll(const std::vector<std::string> &compilers, int* pFailureCount)
+{
+    *pFailureCount = 0;
+
+    glbBenchMakeDirectory(GLB_BENCH_OUTPUT_DIR);
+
+    // A version of 0 is for GLBIND_MAX_GL_VERSION not being defined.
+    std::vector<int> versions(1, 0);
+    glbResult result = glbBenchGetVersionThresholds(std::string(GLB_BENCH_HEADER_DIR) + "/glbind.h", versions);
+    if (result != GLB_SUCCESS) {
+        printf("Failed to read %s/glbind.h\n", GLB_BENCH_HEADER_DIR);
+        return result;
+    }
+
+    for (size_t iCompiler = 0; iCompiler < compilers.size(); ++iCompiler) {
+        int checkCount = 0;
+        for (size_t iVersion = 0; iVersion < versions.size(); ++iVersion) {
+            for (int options = 0; options < 4; ++options) {
+                bool noCompatibility = (options & 1) != 0;
+                bool implementation  = (options & 2) != 0;
+
+                std::string name = "check";
+                std::string prologue;
+                if (versions[iVersion] != 0) {
+                    name += "-" + std::to_string(versions[iVersion]);
+                    prologue += "#define GLBIND_MAX_GL_VERSION " + std::to_string(versions[iVersion]) + "\n";
+                }
+                if (noCompatibility) {
+                    name += "-core";
+                    prologue += "#define GLBIND_NO_COMPATIBILITY\n";
+                }
+                if (implementation) {
+                    name += "-impl";
+                    prologue += "#define GLBIND_IMPLEMENTATION\n";
+                }
+
+                std::string sourcePath = std::string(GLB_BENCH_OUTPUT_DIR) + "/" + name + ".c";
+                result = glbBenchWriteTextFile(sourcePath, prologue + g_CheckProgram);
+                if (result != GLB_SUCCESS) {
+                    return result;
+                }
+
+                // Only the configuration with everything included is run. See g_CheckProgram.
+                bool run = (versions[iVersion] == 0 && !noCompatibility && implementation);
+
+                std::vector<std::string> args;
+                args.push_back(compilers[iCompiler]);
+                args.push_back("-std=c99");
+                args.push_back("-Wall");
+                args.push_back("-Wextra");
+                args.push_back("-pedantic");
+                args.push_back("-Werror");
+                args.push_back(std::string("-I") + GLB_BENCH_HEADER_DIR);
+                if (!run) {
+                    args.push_back("-c");
+                }
+                args.push_back(sourcePath);
+                args.push_back("-o");
+                args.push_back(std::string(GLB_BENCH_OUTPUT_DIR) + (run ? "/check" : "/check.o"));
+                if (run) {
+                    args.push_back("-ldl");
+                    args.push_back("-lpthread");
+                }
+
+                std::string outputPath = std::string(GLB_BENCH_OUTPUT_DIR) + "/" + name + "-" + compilers[iCompiler] + ".txt";
+                double wallMS;
+                long peakKB;
+                result = glbBenchRun(args, outputPath.c_str(), &wallMS, &peakKB);
+                if (result == GLB_NOT_FOUND) {
+                    break;
+                }
+                if (result == GLB_SUCCESS && run) {
+                    std::vector<std::string> runArgs(1, std::string("./") + GLB_BENCH_OUTPUT_DIR + "/check");
+                    result = glbBenchRun(runArgs, outputPath.c_str(), &wallMS, &peakKB);
+                }
+                if (result != GLB_SUCCESS) {
+                    printf("%-8s %-24s failed. See %s.\n", compilers[iCompiler].c_str(), name.c_str(), outputPath.c_str());
+                    *pFailureCount += 1;
+                }
+
+                checkCount += 1;
+            }
+
+            if (result == GLB_NOT_FOUND) {
+                break;
+            }
+        }
+
+        if (result == GLB_NOT_FOUND) {
+            printf("%-8s not found, skipping.\n", compilers[iCompiler].c_str());
+        } else {
+            printf("%-8s %d configurations checked.\n", compilers[iCompiler].c_str(), checkCount);
+        }
+    }
+
+    return GLB_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> compilers = glbBenchSplit("gcc,clang", ',');
+    std::vector<std::string> scales = glbBenchSplit("1,4,16", ',');
+    std::vector<std::string> threadCounts = glbBenchSplit("1,2,4,8", ',');
+    std::string buildPath = GLB_BENCH_BUILD_PATH;
+    std::string registryDir = GLB_BENCH_REGISTRY_PATH;
+    std::string reportPath;
+    std::string baselinePath;
+    double thresholdPercent = 10;
+    int runs = 5;
+    bool benchGenerator = false;
+    bool benchInit = false;
+    bool check = false;
+
+    for (int iArg = 1; iArg < argc; ++iArg) {
+        const char* arg = argv[iArg];
+
+        // Options taking a value.
+        const char* value = NULL;
+        if (strcmp(arg, "--cc") == 0 || strcmp(arg, "--scales") == 0 || strcmp(arg, "--registry") == 0 || strcmp(arg, "--runs") == 0 ||
+            strcmp(arg, "--threads") == 0 || strcmp(arg, "--build") == 0 || strcmp(arg, "--output") == 0 || strcmp(arg, "--baseline") == 0 || strcmp(arg, "--threshold") == 0) {
+            if (iArg + 1 == argc) {
+                printf("Missing value for %s\n", arg);
+                return GLB_INVALID_ARGS;
+            }
+
+            value = argv[++iArg];
+        }
+
+        if (strcmp(arg, "--cc") == 0) {
+            compilers = glbBenchSplit(value, ',');
+        } else if (strcmp(arg, "--generator") == 0) {
+            benchGenerator = true;
+        } else if (strcmp(arg, "--scales") == 0) {
+            scales = glbBenchSplit(value, ',');
+        } else if (strcmp(arg, "--registry") == 0) {
+            registryDir = value;
+        } else if (strcmp(arg, "--init") == 0) {
+            benchInit = true;
+        } else if (strcmp(arg, "--check") == 0) {
+            check = true;
+        } else if (strcmp(arg, "--threads") == 0) {
+            threadCounts = glbBenchSplit(value, ',');
+        } else if (strcmp(arg, "--runs") == 0) {
+            runs = std::max(atoi(value), 1);
+        } else if (strcmp(arg, "--build") == 0) {
+            buildPath = value;
+        } else if (strcmp(arg, "--output") == 0) {
+            reportPath = value;
+        } else if (strcmp(arg, "--baseline") == 0) {
+            baselinePath = value;
+        } else if (strcmp(arg, "--threshold") == 0) {
+            thresholdPercent = atof(value);
+        } else if (strcmp(arg, "--help") == 0) {
+            glbBenchPrintUsage();
+            return 0;
+        } else {
+            printf("Unknown argument: %s\n", arg);
+            glbBenchPrintUsage();
+            return GLB_INVALID_ARGS;
+        }
+    }
+
+    // Checking doesn't produce a report.
+    if (check) {
+        int failureCount;
+        glbResult result = glbBenchCheckAll(compilers, &failureCount);
+        if (result != GLB_SUCCESS) {
+            return result;
+        }
+
+        if (failureCount > 0) {
+            printf("\n%d configuration(s) failed.\n", failureCount);
+            return GLB_ERROR;
+        }
+
+        return 0;
+    }
+
+    if (reportPath.empty()) {
+        reportPath = benchGenerator ? GLB_BENCH_GENERATOR_REPORT_PATH : (benchInit ? GLB_BENCH_INIT_REPORT_PATH : GLB_BENCH_REPORT_PATH);
+    }
+
+    // The baseline is loaded first because it might be overwritten by the new report.
+    std::map<std::string, double> baseline;
+    if (!baselinePath.empty() && glbBenchLoadReport(baselinePath.c_str(), baseline) != GLB_SUCCESS) {
+        printf("Failed to read %s\n", baselinePath.c_str());
+        return GLB_FAILED_TO_OPEN_FILE;
+    }
+
+    std::vector<glbBenchResult> results;
+    glbResult result;
+    if (benchGenerator) {
+        result = glbBenchGeneratorAll(scales, buildPath, registryDir, runs, results);
+    } else if (benchInit) {
+        result = glbBenchInitAll(compilers.empty() ? "cc" : compilers.front(), threadCounts, runs, results);
+    } else {
+        result = glbBenchCompileAll(compilers, buildPath, runs, results);
+    }
+
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    const char* title = benchGenerator ? "glbind build tool benchmark" : (benchInit ? "glbind initialization benchmark" : "glbind compile benchmark");
+    result = glbBenchWriteTextFile(reportPath, glbBenchFormatReport(title, results, runs));
+    if (result != GLB_SUCCESS) {
+        printf("Failed to write %s\n", reportPath.c_str());
+        return result;
+    }
+
+    printf("\nReport written to %s\n", reportPath.c_str());
+
+    if (!baseline.empty()) {
+        int regressionCount = glbBenchCompare(results, baseline, thresholdPercent);
+        if (regressionCount > 0) {
+            printf("\n%d regression(s) over %.1f%%.\n", regressionCount, thresholdPercent);
+            return GLB_ERROR;
+        }
+    }
+
+    return 0;
+}
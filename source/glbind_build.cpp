@@ -1,14 +1,44 @@
 #include "external/tinyxml2.cpp"
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
 #include <algorithm>
+#include <chrono>
 #include <stdio.h>
 #include <assert.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
-#define GLB_BUILD_XML_PATH_GL   "../../resources/gl.xml"
-#define GLB_BUILD_XML_PATH_WGL  "../../resources/wgl.xml"
-#define GLB_BUILD_XML_PATH_GLX  "../../resources/glx.xml"
+#define GLB_BUILD_REGISTRY_PATH "../../resources"
 #define GLB_BUILD_TEMPLATE_PATH "../../source/glbind_template.h"
+#define GLB_BUILD_OUTPUT_PATH   "../../glbind.h"
+#define GLB_BUILD_CACHE_NAME    "glbind_build.cache"   // Placed next to the output file unless --cache is used.
+
+// The template is split at these lines when the implementation is output to a separate source file.
+#define GLB_BUILD_TEMPLATE_HEADER_END           "#endif  /* GLBIND_H */\n"
+#define GLB_BUILD_TEMPLATE_IMPLEMENTATION_BEG   "#ifdef GLBIND_IMPLEMENTATION\n"
+#define GLB_BUILD_TEMPLATE_IMPLEMENTATION_END   "#endif  /* GLBIND_IMPLEMENTATION */\n"
+
+// The maximum length of a single string literal we'll output. Anything longer than this will be split. This is the minimum length
+// C89 compilers are required to support.
+#define GLB_BUILD_MAX_STRING_LITERAL_LENGTH 509
 
 // Edit these if you want to blacklist specific extensions.
 static const char* g_BlacklistedExtensions[] = {
@@ -22,6 +52,53 @@ static const char* g_BlacklistedExtensionVendors[] = {
     ""
 };
 
+// The types of the members of GLBlimits. These match GLBIND_LIMIT_* in the template.
+#define GLB_LIMIT_INT           0   // glGetIntegerv()
+#define GLB_LIMIT_INT64         1   // glGetInteger64v()
+#define GLB_LIMIT_FLOAT         2   // glGetFloatv()
+#define GLB_LIMIT_INDEXED_INT   3   // glGetIntegeri_v(), once for each value.
+
+struct glbLimitInfo
+{
+    const char* name;
+    int type;
+    int count;
+};
+
+// The registry doesn't say what type a pname is, or how many values it returns. Limits not listed here are a single GLint.
+static const glbLimitInfo g_LimitInfos[] = {
+    {"GL_MAX_VIEWPORT_DIMS",                                GLB_LIMIT_INT,         2},
+    {"GL_MAX_COMPUTE_WORK_GROUP_COUNT",                     GLB_LIMIT_INDEXED_INT, 3},
+    {"GL_MAX_COMPUTE_WORK_GROUP_SIZE",                      GLB_LIMIT_INDEXED_INT, 3},
+    {"GL_MAX_TEXTURE_LOD_BIAS",                             GLB_LIMIT_FLOAT,       1},
+    {"GL_MAX_TEXTURE_MAX_ANISOTROPY",                       GLB_LIMIT_FLOAT,       1},
+    {"GL_MAX_FRAGMENT_INTERPOLATION_OFFSET",                GLB_LIMIT_FLOAT,       1},
+    {"GL_MAX_ELEMENT_INDEX",                                GLB_LIMIT_INT64,       1},
+    {"GL_MAX_SERVER_WAIT_TIMEOUT",                          GLB_LIMIT_INT64,       1},
+    {"GL_MAX_SHADER_STORAGE_BLOCK_SIZE",                    GLB_LIMIT_INT64,       1},
+    {"GL_MAX_UNIFORM_BLOCK_SIZE",                           GLB_LIMIT_INT64,       1},
+    {"GL_MAX_COMBINED_VERTEX_UNIFORM_COMPONENTS",           GLB_LIMIT_INT64,       1},
+    {"GL_MAX_COMBINED_GEOMETRY_UNIFORM_COMPONENTS",         GLB_LIMIT_INT64,       1},
+    {"GL_MAX_COMBINED_TESS_CONTROL_UNIFORM_COMPONENTS",     GLB_LIMIT_INT64,       1},
+    {"GL_MAX_COMBINED_TESS_EVALUATION_UNIFORM_COMPONENTS",  GLB_LIMIT_INT64,       1},
+    {"GL_MAX_COMBINED_FRAGMENT_UNIFORM_COMPONENTS",         GLB_LIMIT_INT64,       1},
+    {"GL_MAX_COMBINED_COMPUTE_UNIFORM_COMPONENTS",          GLB_LIMIT_INT64,       1}
+};
+
+// Limits which aren't queried with glGet*(). These are only needed for registries that don't have group information.
+static const char* g_LimitExclusions[] = {
+    "GL_MAX_CONVOLUTION_WIDTH",             // glGetConvolutionParameteriv()
+    "GL_MAX_CONVOLUTION_HEIGHT",
+    "GL_MAX_NAME_LENGTH",                   // glGetProgramInterfaceiv()
+    "GL_MAX_NUM_ACTIVE_VARIABLES",
+    "GL_MAX_NUM_COMPATIBLE_SUBROUTINES",
+    "GL_MAX_WIDTH",                         // glGetInternalformativ()
+    "GL_MAX_HEIGHT",
+    "GL_MAX_DEPTH",
+    "GL_MAX_LAYERS",
+    "GL_MAX_COMBINED_DIMENSIONS"
+};
+
 
 typedef int glbResult;
 #define GLB_SUCCESS                 0
@@ -53,41 +130,6 @@ std::string glbTrim(const std::string &s)
     return glbLTrim(glbRTrim(s));
 }
 
-std::string glbReplaceAll(const std::string &source, const std::string &from, const std::string &to)
-{
-    std::string result;
-    std::string::size_type lastPos = 0;
-
-    for (;;) {
-        std::string::size_type findPos = source.find(from, lastPos);
-        if (findPos == std::string::npos) {
-            break;
-        }
-
-        result.append(source, lastPos, findPos - lastPos);
-        result.append(to);
-        lastPos = findPos + from.length();
-    }
-
-    result.append(source.substr(lastPos));
-    return result;
-}
-
-void glbReplaceAllInline(std::string &source, const std::string &from, const std::string &to)
-{
-    source = glbReplaceAll(source, from, to);
-}
-
-std::string glbToUpper(const std::string &source)
-{
-    // Quick and dirty...
-    std::string upper;
-    for (size_t i = 0; i < source.size(); ++i) {
-        upper += (char)std::toupper(source[i]);
-    }
-    return upper;
-}
-
 bool glbContains(const std::string &source, const char* other)
 {
     return source.find(other) != std::string::npos;
@@ -242,1495 +284,4757 @@ glbResult glbOpenAndWriteTextFile(const char* filePath, const char* text)
     return glbOpenAndWriteFile(filePath, text, strlen(text));
 }
 
-
-
-struct glbType
+// Read-only memory mapping of a whole file. The registry files are mapped rather than read so the parser can work directly on the
+// page cache without an intermediary copy.
+struct glbMappedFile
 {
-    std::string name;       // Can be an attribute of an inner tag.
-    std::string valueC;     // The value as C code.
-    std::string requires;
+    const char* pData;
+    size_t size;
+#if defined(_WIN32)
+    HANDLE hFile;
+    HANDLE hMapping;
+#else
+    int fd;
+#endif
 };
 
-struct glbEnum
+glbResult glbMapFile(const char* filePath, glbMappedFile* pMappedFile)
 {
-    std::string name;
-    std::string value;      // Can be an empty string.
-    std::string type;
-};
+    if (filePath == NULL || pMappedFile == NULL) {
+        return GLB_INVALID_ARGS;
+    }
 
-struct glbGroup
-{
-    std::string name;
-    std::vector<glbEnum> enums;
-};
+    memset(pMappedFile, 0, sizeof(*pMappedFile));
+    pMappedFile->pData = "";
 
-struct glbEnums
-{
-    std::string name;
-    std::string namespaceAttrib;
-    std::string group;
-    std::string vendor;
-    std::string type;
-    std::string start;
-    std::string end;
-    std::vector<glbEnum> enums;
-};
+#if defined(_WIN32)
+    LARGE_INTEGER fileSize;
 
-struct glbCommandParam
-{
-    std::string type;
-    std::string typeC;
-    std::string name;
-    std::string group;  // Attribute.
-};
+    pMappedFile->hFile = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (pMappedFile->hFile == INVALID_HANDLE_VALUE) {
+        return GLB_FAILED_TO_OPEN_FILE;
+    }
 
-struct glbCommand
-{
-    std::string returnType;
-    std::string returnTypeC;
-    std::string name;
-    std::vector<glbCommandParam> params;
-    std::string alias;
-};
+    if (!GetFileSizeEx(pMappedFile->hFile, &fileSize) || (uint64_t)fileSize.QuadPart > SIZE_MAX) {
+        CloseHandle(pMappedFile->hFile);
+        return GLB_FILE_TOO_BIG;
+    }
 
-struct glbCommands
-{
-    std::string namespaceAttrib;
-    std::vector<glbCommand> commands;
-};
+    pMappedFile->size = (size_t)fileSize.QuadPart;
+    if (pMappedFile->size == 0) {
+        return GLB_SUCCESS;     // Can't map an empty file.
+    }
 
-struct glbRequire
-{
-    std::vector<std::string> types;
-    std::vector<std::string> enums;
-    std::vector<std::string> commands;
-};
+    pMappedFile->hMapping = CreateFileMappingA(pMappedFile->hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (pMappedFile->hMapping == NULL) {
+        CloseHandle(pMappedFile->hFile);
+        return GLB_FAILED_TO_READ_FILE;
+    }
 
-struct glbFeature
-{
-    std::string api;
-    std::string name;
-    std::string number;
-    std::vector<glbRequire> requires;
-};
+    pMappedFile->pData = (const char*)MapViewOfFile(pMappedFile->hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (pMappedFile->pData == NULL) {
+        CloseHandle(pMappedFile->hMapping);
+        CloseHandle(pMappedFile->hFile);
+        return GLB_FAILED_TO_READ_FILE;
+    }
+#else
+    struct stat info;
 
-struct glbExtension
-{
-    std::string name;
-    std::string supported;
-    std::vector<glbRequire> requires;
-};
+    pMappedFile->fd = open(filePath, O_RDONLY);
+    if (pMappedFile->fd == -1) {
+        return GLB_FAILED_TO_OPEN_FILE;
+    }
 
-struct glbBuild
-{
-    std::vector<glbType>      types;
-    std::vector<glbGroup>     groups;
-    std::vector<glbEnums>     enums;
-    std::vector<glbCommands>  commands;
-    std::vector<glbFeature>   features;
-    std::vector<glbExtension> extensions;
+    if (fstat(pMappedFile->fd, &info) != 0 || (uint64_t)info.st_size > SIZE_MAX) {
+        close(pMappedFile->fd);
+        return GLB_FILE_TOO_BIG;
+    }
 
-    std::vector<std::string> outputTypes;
-    std::vector<std::string> outputEnums;
-    std::vector<std::string> outputCommands;
-};
+    pMappedFile->size = (size_t)info.st_size;
+    if (pMappedFile->size == 0) {
+        return GLB_SUCCESS;     // Can't map an empty file.
+    }
 
-glbResult glbBuildParseTypes(glbBuild &context, tinyxml2::XMLNode* pXMLElement)
+    void* pData = mmap(NULL, pMappedFile->size, PROT_READ, MAP_PRIVATE, pMappedFile->fd, 0);
+    if (pData == MAP_FAILED) {
+        close(pMappedFile->fd);
+        return GLB_FAILED_TO_READ_FILE;
+    }
+
+    madvise(pData, pMappedFile->size, MADV_SEQUENTIAL);     // The parser reads front to back exactly once.
+    pMappedFile->pData = (const char*)pData;
+#endif
+
+    return GLB_SUCCESS;
+}
+
+void glbUnmapFile(glbMappedFile* pMappedFile)
 {
-    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
-        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
-        if (pChildElement == NULL) {
-            continue;
-        }
+    if (pMappedFile == NULL) {
+        return;
+    }
 
-        // Ignore <comment> tags.
-        if (strcmp(pChildElement->Name(), "comment") == 0) {
-            continue;
-        }
+#if defined(_WIN32)
+    if (pMappedFile->size > 0) {
+        UnmapViewOfFile(pMappedFile->pData);
+        CloseHandle(pMappedFile->hMapping);
+    }
+    CloseHandle(pMappedFile->hFile);
+#else
+    if (pMappedFile->size > 0) {
+        munmap((void*)pMappedFile->pData, pMappedFile->size);
+    }
+    close(pMappedFile->fd);
+#endif
 
-        const char* name = pChildElement->Attribute("name");
-        const char* requires = pChildElement->Attribute("requires");
+    memset(pMappedFile, 0, sizeof(*pMappedFile));
+}
 
-        glbType type;
-        type.name     = (name     != NULL) ? name     : "";
-        type.requires = (requires != NULL) ? requires : "";
 
-        // The inner content of the child will contain the C code. We need to parse this by simply appending the text content together.
-        for (tinyxml2::XMLNode* pInnerChild = pChild->FirstChild(); pInnerChild != NULL; pInnerChild = pInnerChild->NextSibling()) {
-            tinyxml2::XMLElement* pInnerChildElement = pInnerChild->ToElement();
-            if (pInnerChildElement != NULL) {
-                if (strcmp(pInnerChildElement->Name(), "name") == 0) {
-                    type.name = pInnerChildElement->FirstChild()->Value();
-                    type.valueC += type.name;
-                }
-                if (strcmp(pInnerChildElement->Name(), "apientry") == 0) {
-                    type.valueC += "APIENTRY";
-                }
-            } else {
-                type.valueC += pInnerChild->Value();
-            }
-        }
+// 64-bit FNV-1a. Used for detecting changes to input and output files.
+#define GLB_HASH_INIT   14695981039346656037ULL
 
-        context.types.push_back(type);
+uint64_t glbHash(uint64_t hash, const void* pData, size_t dataSize)
+{
+    const unsigned char* p = (const unsigned char*)pData;
+    for (size_t i = 0; i < dataSize; ++i) {
+        hash = (hash ^ p[i]) * 1099511628211ULL;
     }
 
-    return GLB_SUCCESS;
+    return hash;
 }
 
-glbResult glbBuildParseEnum(glbBuild &context, tinyxml2::XMLElement* pXMLElement, glbEnum &theEnum)
+// Hashes the content of a file. A file that doesn't exist will return GLB_FAILED_TO_OPEN_FILE.
+glbResult glbHashFile(uint64_t hash, const char* filePath, uint64_t* pHash)
 {
-    (void)context;
+    glbMappedFile file;
+    glbResult result = glbMapFile(filePath, &file);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
 
-    const char* name  = pXMLElement->Attribute("name");
-    const char* value = pXMLElement->Attribute("value");
-    const char* type  = pXMLElement->Attribute("type");
+    // The size goes in first so that moving bytes from the end of one file to the start of the next changes the hash.
+    uint64_t fileSize = file.size;
+    hash = glbHash(hash, &fileSize, sizeof(fileSize));
+    hash = glbHash(hash, file.pData, file.size);
 
-    theEnum.name  = (name  != NULL) ? name  : "";
-    theEnum.value = (value != NULL) ? value : "";
-    theEnum.type  = (type  != NULL) ? type  : "";
+    glbUnmapFile(&file);
 
+    *pHash = hash;
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildParseEnums(glbBuild &context, tinyxml2::XMLElement* pXMLElement)
+
+// Names and types are repeated many times throughout the registry. "GLenum" alone is used tens of thousands of times. Each distinct string
+// is stored once in a global pool and the registry refers to it with a 32-bit ID, which makes comparing and hashing names an integer
+// operation and keeps the registry small.
+//
+// Strings are never moved or removed once they're in the pool, so a reference returned by glbStringPoolGet() stays valid. Strings can be
+// added from several threads at once since the XML files are loaded in parallel. Getting a string doesn't lock. That's safe because an ID
+// can only have been obtained after its string was added.
+#define GLB_STRING_POOL_CHUNK_SIZE  4096
+#define GLB_STRING_POOL_MAX_CHUNKS  16384
+
+struct glbStringPoolKey
 {
-    const char* name   = pXMLElement->Attribute("name");
-    const char* namespaceAttrib = pXMLElement->Attribute("namespace");
-    const char* group  = pXMLElement->Attribute("group");
-    const char* vendor = pXMLElement->Attribute("vendor");
-    const char* type   = pXMLElement->Attribute("type");
-    const char* start  = pXMLElement->Attribute("start");
-    const char* end    = pXMLElement->Attribute("end");
+    const char* pData;      // Points into a string in the pool.
+    size_t length;
 
-    glbEnums enums;
-    enums.name            = (name            != NULL) ? name            : "";
-    enums.namespaceAttrib = (namespaceAttrib != NULL) ? namespaceAttrib : "";
-    enums.group           = (group           != NULL) ? group           : "";
-    enums.vendor          = (vendor          != NULL) ? vendor          : "";
-    enums.type            = (type            != NULL) ? type            : "";
-    enums.start           = (start           != NULL) ? start           : "";
-    enums.end             = (end             != NULL) ? end             : "";
+    bool operator==(const glbStringPoolKey &other) const
+    {
+        return length == other.length && memcmp(pData, other.pData, length) == 0;
+    }
+};
 
-    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
-        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
-        if (pChildElement == NULL) {
-            continue;
-        }
+struct glbStringPoolKeyHash
+{
+    size_t operator()(const glbStringPoolKey &key) const
+    {
+        return (size_t)glbHash(GLB_HASH_INIT, key.pData, key.length);
+    }
+};
 
-        // Ignore <comment> tags.
-        if (strcmp(pChildElement->Name(), "enum") == 0) {
-            glbEnum theEnum;
-            glbResult result = glbBuildParseEnum(context, pChildElement, theEnum);
-            if (result == GLB_SUCCESS) {
-                enums.enums.push_back(theEnum);
-            }
-        }
+struct glbStringPool
+{
+    std::mutex lock;
+    std::unordered_map<glbStringPoolKey, uint32_t, glbStringPoolKeyHash> ids;
+    std::unique_ptr<std::string[]> chunks[GLB_STRING_POOL_MAX_CHUNKS];
+    uint32_t count;
+
+    glbStringPool()
+    {
+        // ID 0 is always the empty string so that default constructed strings don't need to touch the pool.
+        chunks[0].reset(new std::string[GLB_STRING_POOL_CHUNK_SIZE]);
+        ids.emplace(glbStringPoolKey{chunks[0][0].data(), 0}, 0);
+        count = 1;
     }
+};
 
-    context.enums.push_back(enums);
+glbStringPool g_StringPool;
 
-    return GLB_SUCCESS;
+const std::string& glbStringPoolGet(uint32_t id)
+{
+    return g_StringPool.chunks[id / GLB_STRING_POOL_CHUNK_SIZE][id % GLB_STRING_POOL_CHUNK_SIZE];
 }
 
-glbResult glbBuildParseGroup(glbBuild &context, tinyxml2::XMLElement* pXMLElement, glbGroup &group)
+uint32_t glbStringPoolAdd(const char* pData, size_t length)
 {
-    const char* name = pXMLElement->Attribute("name");
+    std::lock_guard<std::mutex> guard(g_StringPool.lock);
 
-    group.name = (name != NULL) ? name : "";
+    glbStringPoolKey key = {pData, length};
+    auto existing = g_StringPool.ids.find(key);
+    if (existing != g_StringPool.ids.end()) {
+        return existing->second;
+    }
 
-    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
-        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
-        if (pChildElement == NULL) {
-            continue;
-        }
+    uint32_t id = g_StringPool.count;
+    size_t iChunk = id / GLB_STRING_POOL_CHUNK_SIZE;
+    if (iChunk == GLB_STRING_POOL_MAX_CHUNKS) {
+        printf("Too many distinct strings in the registry.\n");
+        abort();
+    }
 
-        if (strcmp(pChildElement->Name(), "enum") == 0) {
-            glbEnum theEnum;
-            glbResult result = glbBuildParseEnum(context, pChildElement, theEnum);
-            if (result == GLB_SUCCESS) {
-                group.enums.push_back(theEnum);
-            }
-        }
+    std::unique_ptr<std::string[]> &chunk = g_StringPool.chunks[iChunk];
+    if (chunk == NULL) {
+        chunk.reset(new std::string[GLB_STRING_POOL_CHUNK_SIZE]);
     }
 
-    return GLB_SUCCESS;
+    std::string &str = chunk[id % GLB_STRING_POOL_CHUNK_SIZE];
+    str.assign(pData, length);
+
+    key.pData = str.data();
+    g_StringPool.ids.emplace(key, id);
+    g_StringPool.count += 1;
+
+    return id;
 }
 
-glbResult glbBuildParseGroups(glbBuild &context, tinyxml2::XMLElement* pXMLElement)
+// An interned string. Converts to a const std::string& so it can be used mostly like a normal string, but comparisons between two
+// glbStrings only compare IDs. The default is the empty string.
+struct glbString
 {
-    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
-        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
-        if (pChildElement == NULL) {
-            continue;
-        }
+    uint32_t id;
 
-        if (strcmp(pChildElement->Name(), "group") == 0) {
-            glbGroup group;
-            glbResult result = glbBuildParseGroup(context, pChildElement, group);
-            if (result == GLB_SUCCESS) {
-                context.groups.push_back(group);
-            }
-        }
-    }
+    glbString() : id(0) {}
+    explicit glbString(const char* str) : id(glbStringPoolAdd(str, strlen(str))) {}
+    explicit glbString(const std::string &str) : id(glbStringPoolAdd(str.data(), str.size())) {}
 
-    return GLB_SUCCESS;
-}
+    glbString& operator=(const std::string &str) { id = glbStringPoolAdd(str.data(), str.size()); return *this; }
+    glbString& operator=(const char* str)        { id = glbStringPoolAdd(str, strlen(str)); return *this; }
 
-glbResult glbBuildParseTypeNamePair(tinyxml2::XMLElement* pXMLElement, std::string &type, std::string &typeC, std::string &name)
-{
-    // Everything up to the name is the type. We set "type" to the value inside the <type> or <ptype> tag, if any. "typeC" will be set to the
-    // whole type up to, but not including, the <name> tag.
-    type  = "";
-    typeC = "";
-    name  = "";
+    const std::string& str() const { return glbStringPoolGet(id); }
+    const char* c_str() const { return str().c_str(); }
+    size_t size() const { return str().size(); }
+    bool empty() const { return str().empty(); }
+    operator const std::string&() const { return str(); }
+};
+
+bool operator==(const glbString &a, const glbString &b) { return a.id == b.id; }
+bool operator!=(const glbString &a, const glbString &b) { return a.id != b.id; }
+bool operator==(const glbString &a, const std::string &b) { return a.str() == b; }
+bool operator!=(const glbString &a, const std::string &b) { return a.str() != b; }
+bool operator==(const std::string &a, const glbString &b) { return a == b.str(); }
+bool operator!=(const std::string &a, const glbString &b) { return a != b.str(); }
+bool operator==(const glbString &a, const char* b) { return a.str() == b; }
+bool operator!=(const glbString &a, const char* b) { return a.str() != b; }
+
+namespace std
+{
+    template <> struct hash<glbString>
+    {
+        size_t operator()(const glbString &str) const { return str.id; }
+    };
+}
+
+
+// Buffered writer for generated code. Text is appended into fixed size chunks which are never moved or reallocated, so building a large
+// output doesn't result in repeated copying of everything that's been written so far. When finished, the chunks are streamed straight
+// to a file rather than being combined into a single buffer.
+#define GLB_OUTPUT_CHUNK_SIZE   (64*1024)
+
+struct glbOutputChunk
+{
+    char data[GLB_OUTPUT_CHUNK_SIZE];
+    size_t size;
+};
+
+struct glbOutput
+{
+    std::vector<std::unique_ptr<glbOutputChunk>> chunks;
+    size_t size = 0;
+};
+
+// Wraps a string so that it's upper-cased as it's written to a glbOutput. Used for the names of function pointer types.
+struct glbUpperCase
+{
+    const std::string &str;
+};
+
+glbUpperCase glbToUpperCase(const std::string &str)
+{
+    glbUpperCase upper = {str};
+    return upper;
+}
+
+// Wraps a character so that it's written to a glbOutput a number of times in a row. Used for indentation.
+struct glbRepeat
+{
+    char c;
+    size_t count;
+};
+
+glbRepeat glbRepeatChar(char c, size_t count)
+{
+    glbRepeat repeat = {c, count};
+    return repeat;
+}
+
+char* glbOutputReserve(glbOutput &output, size_t* pLength)
+{
+    if (output.chunks.empty() || output.chunks.back()->size == GLB_OUTPUT_CHUNK_SIZE) {
+        output.chunks.emplace_back(new glbOutputChunk);
+        output.chunks.back()->size = 0;
+    }
+
+    glbOutputChunk* pChunk = output.chunks.back().get();
+    if (*pLength > GLB_OUTPUT_CHUNK_SIZE - pChunk->size) {
+        *pLength = GLB_OUTPUT_CHUNK_SIZE - pChunk->size;
+    }
+
+    pChunk->size += *pLength;
+    output.size  += *pLength;
+
+    return pChunk->data + pChunk->size - *pLength;
+}
+
+void glbOutputAppend(glbOutput &output, const char* pText, size_t length)
+{
+    while (length > 0) {
+        size_t chunkLength = length;
+        char* pDst = glbOutputReserve(output, &chunkLength);
+        memcpy(pDst, pText, chunkLength);
+
+        pText  += chunkLength;
+        length -= chunkLength;
+    }
+}
+
+// Appends everything written to another output.
+void glbOutputAppendOutput(glbOutput &output, const glbOutput &other)
+{
+    for (size_t iChunk = 0; iChunk < other.chunks.size(); ++iChunk) {
+        glbOutputAppend(output, other.chunks[iChunk]->data, other.chunks[iChunk]->size);
+    }
+}
+
+// Removes a new line character from the end of the output, if there is one.
+void glbOutputTrimNewLine(glbOutput &output)
+{
+    if (output.size > 0 && output.chunks.back()->data[output.chunks.back()->size - 1] == '\n') {
+        output.chunks.back()->size -= 1;
+        output.size -= 1;
+    }
+}
+
+glbOutput& operator<<(glbOutput &output, const char* text)
+{
+    glbOutputAppend(output, text, strlen(text));
+    return output;
+}
+
+glbOutput& operator<<(glbOutput &output, const std::string &text)
+{
+    glbOutputAppend(output, text.c_str(), text.size());
+    return output;
+}
+
+glbOutput& operator<<(glbOutput &output, char c)
+{
+    glbOutputAppend(output, &c, 1);
+    return output;
+}
+
+glbOutput& operator<<(glbOutput &output, size_t value)
+{
+    char valueStr[32];
+    int length = snprintf(valueStr, sizeof(valueStr), "%zu", value);
+    glbOutputAppend(output, valueStr, (size_t)length);
+    return output;
+}
+
+glbOutput& operator<<(glbOutput &output, const glbUpperCase &upper)
+{
+    for (size_t i = 0; i < upper.str.size(); ++i) {
+        output << (char)std::toupper(upper.str[i]);
+    }
+    return output;
+}
+
+glbOutput& operator<<(glbOutput &output, const glbRepeat &repeat)
+{
+    for (size_t i = 0; i < repeat.count; ++i) {
+        output << repeat.c;
+    }
+    return output;
+}
+
+// Wraps consecutive lines with the same condition in a single #if block. Call this with an empty condition to close the current block.
+void glbOutputSetCondition(glbOutput &codeOut, std::string &currentCondition, const std::string &condition)
+{
+    if (condition == currentCondition) {
+        return;
+    }
+
+    if (!currentCondition.empty()) {
+        codeOut << "#endif\n";
+    }
+    if (!condition.empty()) {
+        codeOut << "#if " << condition << "\n";
+    }
+
+    currentCondition = condition;
+}
+
+glbResult glbOutputWriteToFile(const glbOutput &output, FILE* pFile)
+{
+    for (size_t iChunk = 0; iChunk < output.chunks.size(); ++iChunk) {
+        const glbOutputChunk* pChunk = output.chunks[iChunk].get();
+        if (fwrite(pChunk->data, 1, pChunk->size, pFile) != pChunk->size) {
+            return GLB_FAILED_TO_WRITE_FILE;
+        }
+    }
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbOutputWriteToFilePath(const glbOutput &output, const char* filePath)
+{
+    glbResult result;
+    FILE* pFile;
+
+    result = glbFOpen(filePath, "wb", &pFile);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    result = glbOutputWriteToFile(output, pFile);
+    fclose(pFile);
+
+    return result;
+}
+
+// Returns true if the file exists and has exactly the same content as the output.
+bool glbOutputEqualsFile(const glbOutput &output, const char* filePath)
+{
+    glbMappedFile file;
+    if (glbMapFile(filePath, &file) != GLB_SUCCESS) {
+        return false;
+    }
+
+    bool isEqual = (file.size == output.size);
+    for (size_t iChunk = 0, offset = 0; isEqual && iChunk < output.chunks.size(); ++iChunk) {
+        isEqual = memcmp(file.pData + offset, output.chunks[iChunk]->data, output.chunks[iChunk]->size) == 0;
+        offset += output.chunks[iChunk]->size;
+    }
+
+    glbUnmapFile(&file);
+    return isEqual;
+}
+
+// Same as glbOutputWriteToFilePath(), except the file is left untouched if it already has the same content. This keeps the timestamp
+// stable so build systems don't consider the file to have been modified.
+glbResult glbOutputWriteToFilePathIfChanged(const glbOutput &output, const char* filePath, bool* pWritten)
+{
+    if (glbOutputEqualsFile(output, filePath)) {
+        if (pWritten != NULL) {
+            *pWritten = false;
+        }
+        return GLB_SUCCESS;
+    }
+
+    if (pWritten != NULL) {
+        *pWritten = true;
+    }
+    return glbOutputWriteToFilePath(output, filePath);
+}
+
+
+
+struct glbType
+{
+    glbString name;         // Can be an attribute of an inner tag.
+    std::string valueC;     // The value as C code.
+    glbString requires;
+};
+
+struct glbEnum
+{
+    glbString name;
+    glbString value;        // Can be an empty string.
+    glbString type;
+    glbString group;        // A comma separated list of groups. Older registries list groups separately with <groups> instead.
+};
+
+struct glbGroup
+{
+    std::string name;
+    std::vector<glbEnum> enums;
+};
+
+struct glbEnums
+{
+    std::string name;
+    std::string namespaceAttrib;
+    std::string group;
+    std::string vendor;
+    std::string type;
+    std::string start;
+    std::string end;
+    std::vector<glbEnum> enums;
+};
+
+struct glbCommandParam
+{
+    glbString type;
+    glbString typeC;
+    glbString name;
+    glbString group;    // Attribute.
+};
+
+struct glbCommand
+{
+    glbString returnType;
+    glbString returnTypeC;
+    glbString name;
+    std::vector<glbCommandParam> params;
+    glbString alias;
+};
+
+struct glbCommands
+{
+    std::string namespaceAttrib;
+    std::vector<glbCommand> commands;
+};
+
+// Used for both <require> and <remove>.
+struct glbRequire
+{
+    std::string profile;    // Attribute. Empty if it applies to all profiles.
+    std::string api;        // Attribute. Empty if it applies to all APIs.
+    std::vector<glbString> types;
+    std::vector<glbString> enums;
+    std::vector<glbString> commands;
+};
+
+struct glbFeature
+{
+    std::string api;
+    std::string name;
+    std::string number;
+    std::vector<glbRequire> requires;
+    std::vector<glbRequire> removes;
+};
+
+struct glbExtension
+{
+    std::string name;
+    std::string supported;
+    std::vector<glbRequire> requires;
+};
+
+// Controls what ends up in the output file. By default everything in the registry for desktop OpenGL is output. See
+// glbBuildApplySelection().
+struct glbBuildSelection
+{
+    std::string api = "gl";                         // Features and extensions for this API are output, e.g. "gl" or "gles2".
+    std::string maxVersion;                         // Features with a higher version number are excluded. Empty for all versions.
+    std::string profile;                            // "core", "compatibility" or empty for no profile. See glbBuildIsRequireSelected().
+    bool allExtensions = true;                      // When false, only the extensions in "extensions" are output.
+    std::unordered_set<std::string> extensions;
+    bool wgl = true;
+    bool glx = true;
+};
+
+// The generated file is split into the following sections. Features and extensions for WGL and GLX are wrapped in an #if block for
+// their platform.
+#define GLB_BUILD_SECTION_FEATURES          0
+#define GLB_BUILD_SECTION_WGL_FEATURES      1
+#define GLB_BUILD_SECTION_GLX_FEATURES      2
+#define GLB_BUILD_SECTION_EXTENSIONS        3
+#define GLB_BUILD_SECTION_WGL_EXTENSIONS    4
+#define GLB_BUILD_SECTION_GLX_EXTENSIONS    5
+#define GLB_BUILD_SECTION_COUNT             6
+
+// A feature or extension that's output. Each block can be excluded at compile time with the GLBIND_MAX_GL_VERSION,
+// GLBIND_NO_COMPATIBILITY and GLBIND_ONLY_LISTED_EXTENSIONS options. When a block is included, GLBIND_HAS_<name> is defined.
+struct glbBuildBlock
+{
+    std::string name;
+    const std::vector<glbRequire>* pRequires;
+    int section;
+    std::string condition;  // Preprocessor condition for including the block. Empty if the block is always included.
+};
+
+struct glbBuild
+{
+    glbBuildSelection selection;                    // What the registry has been trimmed to with glbBuildApplySelection().
+
+    std::vector<glbType>      types;
+    std::vector<glbGroup>     groups;
+    std::vector<glbEnums>     enums;
+    std::vector<glbCommands>  commands;
+    std::vector<glbFeature>   features;
+    std::vector<glbExtension> extensions;
+
+    // Indexes into the lists above for fast lookups by name. These are built with glbBuildIndexRegistry() once all XML files have been
+    // loaded. When a name is defined more than once, the first definition wins.
+    std::unordered_map<glbString, const glbType*>    typesByName;
+    std::unordered_map<glbString, const glbEnum*>    enumsByName;
+    std::unordered_map<glbString, const glbCommand*> commandsByName;
+
+    // Every block in the order they're output, the blocks that require each type and command, and the preprocessor condition for
+    // including each command. These are also built by glbBuildIndexRegistry().
+    std::vector<glbBuildBlock> blocks;
+    std::unordered_map<glbString, std::vector<size_t>> typeBlocks;
+    std::unordered_map<glbString, std::vector<size_t>> commandBlocks;
+    std::unordered_map<glbString, std::string> commandConditions;
+    std::unordered_set<glbString> compatibilityNames;    // Commands and enums removed from, or not part of, the core profile.
+};
 
+glbResult glbBuildParseTypes(glbBuild &context, tinyxml2::XMLNode* pXMLElement)
+{
     for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
         tinyxml2::XMLElement* pChildElement = pChild->ToElement();
-        if (pChildElement != NULL) {
-            if (strcmp(pChildElement->Name(), "name") == 0) {
-                name = pChildElement->FirstChild()->Value();
-                break;
-            } else {
-                typeC += pChildElement->FirstChild()->Value();
-                if (strcmp(pChildElement->Name(), "type") == 0 || strcmp(pChildElement->Name(), "ptype") == 0) {
-                    type = pChildElement->FirstChild()->Value();
+        if (pChildElement == NULL) {
+            continue;
+        }
+
+        // Ignore <comment> tags.
+        if (strcmp(pChildElement->Name(), "comment") == 0) {
+            continue;
+        }
+
+        const char* name = pChildElement->Attribute("name");
+        const char* requires = pChildElement->Attribute("requires");
+
+        glbType type;
+        type.name     = (name     != NULL) ? name     : "";
+        type.requires = (requires != NULL) ? requires : "";
+
+        // The inner content of the child will contain the C code. We need to parse this by simply appending the text content together.
+        for (tinyxml2::XMLNode* pInnerChild = pChild->FirstChild(); pInnerChild != NULL; pInnerChild = pInnerChild->NextSibling()) {
+            tinyxml2::XMLElement* pInnerChildElement = pInnerChild->ToElement();
+            if (pInnerChildElement != NULL) {
+                if (strcmp(pInnerChildElement->Name(), "name") == 0) {
+                    type.name = pInnerChildElement->FirstChild()->Value();
+                    type.valueC += type.name;
+                }
+                if (strcmp(pInnerChildElement->Name(), "apientry") == 0) {
+                    type.valueC += "APIENTRY";
                 }
+            } else if (pInnerChild->ToText() != NULL) {
+                type.valueC += pInnerChild->Value();   // Not comments.
             }
+        }
+
+        context.types.push_back(type);
+    }
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildParseEnum(glbBuild &context, tinyxml2::XMLElement* pXMLElement, glbEnum &theEnum)
+{
+    (void)context;
+
+    const char* name  = pXMLElement->Attribute("name");
+    const char* value = pXMLElement->Attribute("value");
+    const char* type  = pXMLElement->Attribute("type");
+    const char* group = pXMLElement->Attribute("group");
+
+    theEnum.name  = (name  != NULL) ? name  : "";
+    theEnum.value = (value != NULL) ? value : "";
+    theEnum.type  = (type  != NULL) ? type  : "";
+    theEnum.group = (group != NULL) ? group : "";
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildParseEnums(glbBuild &context, tinyxml2::XMLElement* pXMLElement)
+{
+    const char* name   = pXMLElement->Attribute("name");
+    const char* namespaceAttrib = pXMLElement->Attribute("namespace");
+    const char* group  = pXMLElement->Attribute("group");
+    const char* vendor = pXMLElement->Attribute("vendor");
+    const char* type   = pXMLElement->Attribute("type");
+    const char* start  = pXMLElement->Attribute("start");
+    const char* end    = pXMLElement->Attribute("end");
+
+    glbEnums enums;
+    enums.name            = (name            != NULL) ? name            : "";
+    enums.namespaceAttrib = (namespaceAttrib != NULL) ? namespaceAttrib : "";
+    enums.group           = (group           != NULL) ? group           : "";
+    enums.vendor          = (vendor          != NULL) ? vendor          : "";
+    enums.type            = (type            != NULL) ? type            : "";
+    enums.start           = (start           != NULL) ? start           : "";
+    enums.end             = (end             != NULL) ? end             : "";
+
+    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
+        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
+        if (pChildElement == NULL) {
+            continue;
+        }
+
+        // Ignore <comment> tags.
+        if (strcmp(pChildElement->Name(), "enum") == 0) {
+            glbEnum theEnum;
+            glbResult result = glbBuildParseEnum(context, pChildElement, theEnum);
+            if (result == GLB_SUCCESS) {
+                enums.enums.push_back(theEnum);
+            }
+        }
+    }
+
+    context.enums.push_back(enums);
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildParseGroup(glbBuild &context, tinyxml2::XMLElement* pXMLElement, glbGroup &group)
+{
+    const char* name = pXMLElement->Attribute("name");
+
+    group.name = (name != NULL) ? name : "";
+
+    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
+        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
+        if (pChildElement == NULL) {
+            continue;
+        }
+
+        if (strcmp(pChildElement->Name(), "enum") == 0) {
+            glbEnum theEnum;
+            glbResult result = glbBuildParseEnum(context, pChildElement, theEnum);
+            if (result == GLB_SUCCESS) {
+                group.enums.push_back(theEnum);
+            }
+        }
+    }
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildParseGroups(glbBuild &context, tinyxml2::XMLElement* pXMLElement)
+{
+    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
+        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
+        if (pChildElement == NULL) {
+            continue;
+        }
+
+        if (strcmp(pChildElement->Name(), "group") == 0) {
+            glbGroup group;
+            glbResult result = glbBuildParseGroup(context, pChildElement, group);
+            if (result == GLB_SUCCESS) {
+                context.groups.push_back(group);
+            }
+        }
+    }
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildParseTypeNamePair(tinyxml2::XMLElement* pXMLElement, glbString &typeOut, glbString &typeCOut, glbString &nameOut)
+{
+    // Everything up to the name is the type. We set "type" to the value inside the <type> or <ptype> tag, if any. "typeC" will be set to the
+    // whole type up to, but not including, the <name> tag.
+    std::string type;
+    std::string typeC;
+    std::string name;
+
+    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
+        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
+        if (pChildElement != NULL) {
+            if (strcmp(pChildElement->Name(), "name") == 0) {
+                name = pChildElement->FirstChild()->Value();
+                break;
+            } else {
+                typeC += pChildElement->FirstChild()->Value();
+                if (strcmp(pChildElement->Name(), "type") == 0 || strcmp(pChildElement->Name(), "ptype") == 0) {
+                    type = pChildElement->FirstChild()->Value();
+                }
+            }
+        } else if (pChild->ToText() != NULL) {
+            typeC += pChild->Value();
+        }
+    }
+
+    typeOut  = type;
+    typeCOut = glbTrim(typeC);
+    nameOut  = name;
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildParseCommandParam(glbBuild &context, tinyxml2::XMLElement* pXMLElement, glbCommandParam &param)
+{
+    (void)context;
+
+    return glbBuildParseTypeNamePair(pXMLElement, param.type, param.typeC, param.name);
+}
+
+glbResult glbBuildParseCommand(glbBuild &context, tinyxml2::XMLElement* pXMLElement, glbCommand &command)
+{
+    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
+        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
+        if (pChildElement == NULL) {
+            continue;
+        }
+
+        if (strcmp(pChildElement->Name(), "proto") == 0) {
+            glbBuildParseTypeNamePair(pChildElement, command.returnType, command.returnTypeC, command.name);
+        }
+
+        if (strcmp(pChildElement->Name(), "param") == 0) {
+            glbCommandParam param;
+            glbResult result = glbBuildParseCommandParam(context, pChildElement, param);
+            if (result != GLB_SUCCESS) {
+                return result;
+            }
+
+            command.params.push_back(param);
+        }
+
+        if (strcmp(pChildElement->Name(), "alias") == 0) {
+            const char* alias = pChildElement->Attribute("name");
+            command.alias = (alias != NULL) ? alias : "";
+        }
+    }
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildParseCommands(glbBuild &context, tinyxml2::XMLElement* pXMLElement)
+{
+    glbCommands commands;
+
+    const char* namespaceAttrib = pXMLElement->Attribute("namespace");
+    commands.namespaceAttrib = (namespaceAttrib != NULL) ? namespaceAttrib : "";
+
+    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
+        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
+        if (pChildElement == NULL) {
+            continue;
+        }
+
+        if (strcmp(pChildElement->Name(), "command") == 0) {
+            glbCommand command;
+            glbResult result = glbBuildParseCommand(context, pChildElement, command);
+            if (result == GLB_SUCCESS) {
+                commands.commands.push_back(command);
+            }
+        }
+    }
+
+    context.commands.push_back(commands);
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildParseRequire(glbBuild &context, tinyxml2::XMLElement* pXMLElement, glbRequire &require)
+{
+    (void)context;
+
+    const char* profile = pXMLElement->Attribute("profile");
+    const char* api     = pXMLElement->Attribute("api");
+
+    require.profile = (profile != NULL) ? profile : "";
+    require.api     = (api     != NULL) ? api     : "";
+
+    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
+        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
+        if (pChildElement == NULL) {
+            continue;
+        }
+
+        if (strcmp(pChildElement->Name(), "type") == 0) {
+            require.types.push_back(glbString(pChildElement->Attribute("name")));
+        }
+
+        if (strcmp(pChildElement->Name(), "enum") == 0) {
+            require.enums.push_back(glbString(pChildElement->Attribute("name")));
+        }
+
+        if (strcmp(pChildElement->Name(), "command") == 0) {
+            require.commands.push_back(glbString(pChildElement->Attribute("name")));
+        }
+    }
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildParseFeature(glbBuild &context, tinyxml2::XMLElement* pXMLElement)
+{
+    glbFeature feature;
+
+    const char* api    = pXMLElement->Attribute("api");
+    const char* name   = pXMLElement->Attribute("name");
+    const char* number = pXMLElement->Attribute("number");
+
+    feature.api    = (api    != NULL) ? api    : "";
+    feature.name   = (name   != NULL) ? name   : "";
+    feature.number = (number != NULL) ? number : "";
+
+    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
+        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
+        if (pChildElement == NULL) {
+            continue;
+        }
+
+        if (strcmp(pChildElement->Name(), "require") == 0) {
+            glbRequire require;
+            glbResult result = glbBuildParseRequire(context, pChildElement, require);
+            if (result != GLB_SUCCESS) {
+                return result;
+            }
+
+            feature.requires.push_back(require);
+        }
+
+        if (strcmp(pChildElement->Name(), "remove") == 0) {
+            glbRequire remove;
+            glbResult result = glbBuildParseRequire(context, pChildElement, remove);
+            if (result != GLB_SUCCESS) {
+                return result;
+            }
+
+            feature.removes.push_back(remove);
+        }
+    }
+
+    context.features.push_back(feature);
+
+    return GLB_SUCCESS;
+}
+
+
+glbResult glbBuildParseExtension(glbBuild &context, tinyxml2::XMLElement* pXMLElement, glbExtension &extension)
+{
+    const char* name      = pXMLElement->Attribute("name");
+    const char* supported = pXMLElement->Attribute("supported");
+
+    extension.name      = (name      != NULL) ? name      : "";
+    extension.supported = (supported != NULL) ? supported : "";
+
+    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
+        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
+        if (pChildElement == NULL) {
+            continue;
+        }
+
+        if (strcmp(pChildElement->Name(), "require") == 0) {
+            glbRequire require;
+            glbResult result = glbBuildParseRequire(context, pChildElement, require);
+            if (result != GLB_SUCCESS) {
+                return result;
+            }
+
+            extension.requires.push_back(require);
+        }
+    }
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildParseExtensions(glbBuild &context, tinyxml2::XMLElement* pXMLElement)
+{
+    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
+        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
+        if (pChildElement == NULL) {
+            continue;
+        }
+
+        if (strcmp(pChildElement->Name(), "extension") == 0) {
+            glbExtension extension;
+            glbResult result = glbBuildParseExtension(context, pChildElement, extension);
+            if (result != GLB_SUCCESS) {
+                return result;
+            }
+
+            context.extensions.push_back(extension);
+        }
+    }
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildLoadXML(glbBuild &context, tinyxml2::XMLDocument &doc)
+{
+    // The root node is the <registry> node.
+    tinyxml2::XMLElement* pRoot = doc.RootElement();
+    if (pRoot == NULL) {
+        printf("Failed to retrieve root node.\n");
+        return -1;
+    }
+
+    if (strcmp(pRoot->Name(), "registry") != 0) {
+        printf("Unexpected root node. Expecting \"registry\", but got \"%s\"", pRoot->Name());
+        return -1;
+    }
+
+    for (tinyxml2::XMLNode* pChild = pRoot->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
+        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
+        if (pChildElement == NULL) {
+            continue;   // Could be a comment. In any case we don't care about anything that's not in a child node.
+        }
+
+        if (strcmp(pChildElement->Name(), "types") == 0) {
+            glbBuildParseTypes(context, pChildElement);
+        }
+        if (strcmp(pChildElement->Name(), "groups") == 0) {
+            glbBuildParseGroups(context, pChildElement);
+        }
+        if (strcmp(pChildElement->Name(), "enums") == 0) {
+            glbBuildParseEnums(context, pChildElement);
+        }
+        if (strcmp(pChildElement->Name(), "commands") == 0) {
+            glbBuildParseCommands(context, pChildElement);
+        }
+        if (strcmp(pChildElement->Name(), "feature") == 0) {
+            glbBuildParseFeature(context, pChildElement);
+        }
+        if (strcmp(pChildElement->Name(), "extensions") == 0) {
+            glbBuildParseExtensions(context, pChildElement);
+        }
+    }
+
+    return GLB_SUCCESS;
+}
+
+// Loads a registry file by building a full tinyxml2 DOM. This is kept as the reference implementation for the pull parser below. Use
+// --verify-parser to check that both produce the same registry.
+glbResult glbBuildLoadXMLFileDOM(glbBuild &context, const char* filePath)
+{
+    tinyxml2::XMLDocument docGL;
+    tinyxml2::XMLError xmlError = docGL.LoadFile(filePath);
+    if (xmlError != tinyxml2::XML_SUCCESS) {
+        printf("Failed to parse %s\n", filePath);
+        return (int)xmlError;
+    }
+
+    return glbBuildLoadXML(context, docGL);
+}
+
+
+// Pull parser for the registry files. This walks a memory mapped file and reports one element or run of text at a time without building
+// a document tree. Names, attributes and text are views into the mapping. Only the strings the registry actually keeps are copied out,
+// and they are decoded at that point. The decoding rules mirror tinyxml2 with its default settings so that both loaders produce the same
+// registry: whitespace-only text is dropped, entities are expanded and line endings are normalized to "\n". Comments, processing
+// instructions and DTD declarations are skipped. The registry files are trusted input so well-formedness is only loosely checked.
+#define GLB_XML_EVENT_ERROR             -1
+#define GLB_XML_EVENT_END_OF_DOCUMENT   0
+#define GLB_XML_EVENT_START_ELEMENT     1
+#define GLB_XML_EVENT_END_ELEMENT       2
+#define GLB_XML_EVENT_TEXT              3
+
+struct glbStringView
+{
+    const char* p;
+    size_t length;
+};
+
+struct glbXMLPullParser
+{
+    const char* pCursor;
+    const char* pEnd;
+    int event;                  // The most recent event returned by glbXMLNext().
+    int depth;
+    bool isEmptyElement;        // Set for <element/>. The next call to glbXMLNext() will return the matching GLB_XML_EVENT_END_ELEMENT.
+    bool isCDATA;               // Set when the current text is from a CDATA section, in which case entities are not expanded.
+    glbStringView name;         // The element name for GLB_XML_EVENT_START_ELEMENT and GLB_XML_EVENT_END_ELEMENT.
+    glbStringView attributes;   // The raw attribute list of the current start element.
+    glbStringView text;         // The raw text for GLB_XML_EVENT_TEXT.
+};
+
+void glbXMLInit(glbXMLPullParser &parser, const char* pData, size_t dataSize)
+{
+    memset(&parser, 0, sizeof(parser));
+    parser.pCursor = pData;
+    parser.pEnd    = pData + dataSize;
+}
+
+bool glbXMLIsWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+const char* glbXMLFind(const char* pBeg, const char* pEnd, const char* pattern)
+{
+    size_t patternLength = strlen(pattern);
+    for (const char* p = pBeg; p + patternLength <= pEnd; ++p) {
+        p = (const char*)memchr(p, pattern[0], (size_t)(pEnd - p));
+        if (p == NULL || p + patternLength > pEnd) {
+            break;
+        }
+        if (memcmp(p, pattern, patternLength) == 0) {
+            return p;
+        }
+    }
+
+    return NULL;
+}
+
+bool glbXMLStartsWith(const char* pBeg, const char* pEnd, const char* prefix)
+{
+    size_t prefixLength = strlen(prefix);
+    return (size_t)(pEnd - pBeg) >= prefixLength && memcmp(pBeg, prefix, prefixLength) == 0;
+}
+
+bool glbXMLEquals(glbStringView view, const char* str)
+{
+    return strncmp(view.p, str, view.length) == 0 && str[view.length] == '\0';
+}
+
+int glbXMLError(glbXMLPullParser &parser)
+{
+    parser.pCursor = parser.pEnd;
+    parser.event   = GLB_XML_EVENT_ERROR;
+    return parser.event;
+}
+
+// Moves to the next event. Each GLB_XML_EVENT_START_ELEMENT is followed by the events for the content of that element and then a
+// matching GLB_XML_EVENT_END_ELEMENT, including for empty elements.
+int glbXMLNext(glbXMLPullParser &parser)
+{
+    if (parser.event == GLB_XML_EVENT_ERROR) {
+        return parser.event;
+    }
+
+    if (parser.isEmptyElement) {
+        parser.isEmptyElement = false;
+        parser.depth -= 1;
+        parser.event = GLB_XML_EVENT_END_ELEMENT;
+        return parser.event;
+    }
+
+    for (;;) {
+        const char* p    = parser.pCursor;
+        const char* pEnd = parser.pEnd;
+
+        if (p == pEnd) {
+            parser.event = (parser.depth == 0) ? GLB_XML_EVENT_END_OF_DOCUMENT : GLB_XML_EVENT_ERROR;
+            return parser.event;
+        }
+
+        if (*p != '<') {
+            const char* pTextEnd = (const char*)memchr(p, '<', (size_t)(pEnd - p));
+            if (pTextEnd == NULL) {
+                pTextEnd = pEnd;
+            }
+
+            parser.pCursor = pTextEnd;
+
+            // Whitespace between tags and anything outside of the root element is not reported.
+            const char* pNonWhitespace = p;
+            while (pNonWhitespace < pTextEnd && glbXMLIsWhitespace(*pNonWhitespace)) {
+                pNonWhitespace += 1;
+            }
+
+            if (pNonWhitespace == pTextEnd || parser.depth == 0) {
+                continue;
+            }
+
+            parser.text.p      = p;
+            parser.text.length = (size_t)(pTextEnd - p);
+            parser.isCDATA     = false;
+            parser.event       = GLB_XML_EVENT_TEXT;
+            return parser.event;
+        }
+
+        if (glbXMLStartsWith(p, pEnd, "<!--")) {
+            const char* pCommentEnd = glbXMLFind(p + 4, pEnd, "-->");
+            if (pCommentEnd == NULL) {
+                return glbXMLError(parser);
+            }
+
+            parser.pCursor = pCommentEnd + 3;
+            continue;
+        }
+
+        if (glbXMLStartsWith(p, pEnd, "<![CDATA[")) {
+            const char* pCDATAEnd = glbXMLFind(p + 9, pEnd, "]]>");
+            if (pCDATAEnd == NULL) {
+                return glbXMLError(parser);
+            }
+
+            parser.pCursor     = pCDATAEnd + 3;
+            parser.text.p      = p + 9;
+            parser.text.length = (size_t)(pCDATAEnd - parser.text.p);
+            parser.isCDATA     = true;
+            parser.event       = GLB_XML_EVENT_TEXT;
+            return parser.event;
+        }
+
+        if (glbXMLStartsWith(p, pEnd, "<?") || glbXMLStartsWith(p, pEnd, "<!")) {
+            const char* pDeclEnd = (const char*)memchr(p, '>', (size_t)(pEnd - p));
+            if (pDeclEnd == NULL) {
+                return glbXMLError(parser);
+            }
+
+            parser.pCursor = pDeclEnd + 1;
+            continue;
+        }
+
+        if (glbXMLStartsWith(p, pEnd, "</")) {
+            const char* pTagEnd = (const char*)memchr(p, '>', (size_t)(pEnd - p));
+            if (pTagEnd == NULL || parser.depth == 0) {
+                return glbXMLError(parser);
+            }
+
+            const char* pNameEnd = p + 2;
+            while (pNameEnd < pTagEnd && !glbXMLIsWhitespace(*pNameEnd)) {
+                pNameEnd += 1;
+            }
+
+            parser.pCursor     = pTagEnd + 1;
+            parser.name.p      = p + 2;
+            parser.name.length = (size_t)(pNameEnd - parser.name.p);
+            parser.depth      -= 1;
+            parser.event       = GLB_XML_EVENT_END_ELEMENT;
+            return parser.event;
+        }
+
+        // Start tag. The end of the tag is the first '>' that's not inside a quoted attribute value.
+        const char* pNameEnd = p + 1;
+        while (pNameEnd < pEnd && !glbXMLIsWhitespace(*pNameEnd) && *pNameEnd != '/' && *pNameEnd != '>') {
+            pNameEnd += 1;
+        }
+
+        const char* pTagEnd = pNameEnd;
+        while (pTagEnd < pEnd && *pTagEnd != '>') {
+            if (*pTagEnd == '"' || *pTagEnd == '\'') {
+                pTagEnd = (const char*)memchr(pTagEnd + 1, *pTagEnd, (size_t)(pEnd - pTagEnd - 1));
+                if (pTagEnd == NULL) {
+                    return glbXMLError(parser);
+                }
+            }
+            pTagEnd += 1;
+        }
+
+        if (pTagEnd == pEnd || pNameEnd == p + 1) {
+            return glbXMLError(parser);
+        }
+
+        parser.isEmptyElement    = (pTagEnd[-1] == '/');
+        parser.pCursor           = pTagEnd + 1;
+        parser.name.p            = p + 1;
+        parser.name.length       = (size_t)(pNameEnd - parser.name.p);
+        parser.attributes.p      = pNameEnd;
+        parser.attributes.length = (size_t)(pTagEnd - pNameEnd) - (parser.isEmptyElement ? 1 : 0);
+        parser.depth            += 1;
+        parser.event             = GLB_XML_EVENT_START_ELEMENT;
+        return parser.event;
+    }
+}
+
+// Skips over the content of the current element. Must be called right after GLB_XML_EVENT_START_ELEMENT. On output the current event will
+// be the matching GLB_XML_EVENT_END_ELEMENT.
+void glbXMLSkipElement(glbXMLPullParser &parser)
+{
+    int targetDepth = parser.depth - 1;
+    while (parser.depth > targetDepth) {
+        int event = glbXMLNext(parser);
+        if (event == GLB_XML_EVENT_ERROR || event == GLB_XML_EVENT_END_OF_DOCUMENT) {
+            break;
+        }
+    }
+}
+
+// Moves to the next direct child element of the current element, skipping over any text. Returns false when the end of the current
+// element has been reached or an error occurs.
+bool glbXMLNextChildElement(glbXMLPullParser &parser)
+{
+    for (;;) {
+        int event = glbXMLNext(parser);
+        if (event == GLB_XML_EVENT_START_ELEMENT) {
+            return true;
+        }
+        if (event != GLB_XML_EVENT_TEXT) {
+            return false;
+        }
+    }
+}
+
+bool glbXMLIsElement(const glbXMLPullParser &parser, const char* name)
+{
+    return glbXMLEquals(parser.name, name);
+}
+
+// Appends raw text to a string, expanding entities and normalizing line endings. Unknown entities are passed through unchanged.
+void glbXMLAppendDecoded(std::string &str, const char* p, size_t length, bool expandEntities)
+{
+    const char* pEnd = p + length;
+
+    while (p < pEnd) {
+        // Copy everything up to the next character that needs attention in one go.
+        const char* pRun = p;
+        while (p < pEnd && *p != '\r' && !(*p == '&' && expandEntities)) {
+            p += 1;
+        }
+        str.append(pRun, (size_t)(p - pRun));
+
+        if (p == pEnd) {
+            break;
+        }
+
+        if (*p == '\r') {
+            str += '\n';
+            p += 1;
+            if (p < pEnd && *p == '\n') {
+                p += 1;
+            }
+            continue;
+        }
+
+        // Entity.
+        const char* pSemicolon = (const char*)memchr(p, ';', (size_t)(pEnd - p));
+        if (pSemicolon != NULL) {
+            glbStringView entity = {p + 1, (size_t)(pSemicolon - p - 1)};
+
+            if (entity.length > 1 && entity.p[0] == '#') {
+                bool isHex = (entity.p[1] == 'x');
+                unsigned long codepoint = strtoul(std::string(entity.p + (isHex ? 2 : 1), entity.p + entity.length).c_str(), NULL, isHex ? 16 : 10);
+                if (codepoint < 0x80) {
+                    str += (char)codepoint;
+                } else if (codepoint < 0x800) {
+                    str += (char)(0xC0 | (codepoint >> 6));
+                    str += (char)(0x80 | (codepoint & 0x3F));
+                } else if (codepoint < 0x10000) {
+                    str += (char)(0xE0 | (codepoint >> 12));
+                    str += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+                    str += (char)(0x80 | (codepoint & 0x3F));
+                } else {
+                    str += (char)(0xF0 | (codepoint >> 18));
+                    str += (char)(0x80 | ((codepoint >> 12) & 0x3F));
+                    str += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+                    str += (char)(0x80 | (codepoint & 0x3F));
+                }
+                p = pSemicolon + 1;
+                continue;
+            }
+
+            char c = '\0';
+            if (glbXMLEquals(entity, "lt"))   c = '<';
+            if (glbXMLEquals(entity, "gt"))   c = '>';
+            if (glbXMLEquals(entity, "amp"))  c = '&';
+            if (glbXMLEquals(entity, "quot")) c = '"';
+            if (glbXMLEquals(entity, "apos")) c = '\'';
+
+            if (c != '\0') {
+                str += c;
+                p = pSemicolon + 1;
+                continue;
+            }
+        }
+
+        str += '&';
+        p += 1;
+    }
+}
+
+void glbXMLAppendText(const glbXMLPullParser &parser, std::string &str)
+{
+    glbXMLAppendDecoded(str, parser.text.p, parser.text.length, !parser.isCDATA);
+}
+
+// Retrieves the raw value of an attribute of the current start element.
+bool glbXMLFindAttribute(const glbXMLPullParser &parser, const char* name, glbStringView &value)
+{
+    const char* p    = parser.attributes.p;
+    const char* pEnd = parser.attributes.p + parser.attributes.length;
+
+    for (;;) {
+        while (p < pEnd && glbXMLIsWhitespace(*p)) {
+            p += 1;
+        }
+
+        const char* pName = p;
+        while (p < pEnd && *p != '=' && !glbXMLIsWhitespace(*p)) {
+            p += 1;
+        }
+        glbStringView attributeName = {pName, (size_t)(p - pName)};
+
+        while (p < pEnd && *p != '"' && *p != '\'') {
+            p += 1;
+        }
+        if (p == pEnd) {
+            return false;
+        }
+
+        const char* pValue    = p + 1;
+        const char* pValueEnd = (const char*)memchr(pValue, *p, (size_t)(pEnd - pValue));
+        if (pValueEnd == NULL) {
+            return false;
+        }
+
+        if (glbXMLEquals(attributeName, name)) {
+            value.p      = pValue;
+            value.length = (size_t)(pValueEnd - pValue);
+            return true;
+        }
+
+        p = pValueEnd + 1;
+    }
+}
+
+// Returns the decoded value of an attribute of the current start element, or an empty string if it doesn't exist.
+std::string glbXMLAttribute(const glbXMLPullParser &parser, const char* name)
+{
+    std::string str;
+    glbStringView value;
+    if (glbXMLFindAttribute(parser, name, value)) {
+        glbXMLAppendDecoded(str, value.p, value.length, true);
+    }
+
+    return str;
+}
+
+// Same as glbXMLAttribute(), but interns the value. Most values don't have any entities and are interned straight from the file.
+glbString glbXMLAttributeString(const glbXMLPullParser &parser, const char* name)
+{
+    glbStringView value;
+    if (!glbXMLFindAttribute(parser, name, value)) {
+        return glbString();
+    }
+
+    if (memchr(value.p, '&', value.length) == NULL) {
+        glbString str;
+        str.id = glbStringPoolAdd(value.p, value.length);
+        return str;
+    }
+
+    std::string str;
+    glbXMLAppendDecoded(str, value.p, value.length, true);
+    return glbString(str);
+}
+
+// Appends the text content of the current element and moves to its end tag. Nested elements are skipped.
+void glbXMLReadElementText(glbXMLPullParser &parser, std::string &str)
+{
+    for (;;) {
+        int event = glbXMLNext(parser);
+        if (event == GLB_XML_EVENT_TEXT) {
+            glbXMLAppendText(parser, str);
+        } else if (event == GLB_XML_EVENT_START_ELEMENT) {
+            glbXMLSkipElement(parser);
+        } else {
+            break;
+        }
+    }
+}
+
+glbResult glbXMLResult(const glbXMLPullParser &parser)
+{
+    return (parser.event == GLB_XML_EVENT_ERROR) ? GLB_ERROR : GLB_SUCCESS;
+}
+
+
+// The functions below mirror the glbBuildParse*() functions above but read from the pull parser. Each one is called with the parser
+// positioned on the start tag of the relevant element and returns with it positioned on the matching end tag.
+glbResult glbBuildPullParseTypes(glbBuild &context, glbXMLPullParser &parser)
+{
+    while (glbXMLNextChildElement(parser)) {
+        // Ignore <comment> tags.
+        if (glbXMLIsElement(parser, "comment")) {
+            glbXMLSkipElement(parser);
+            continue;
+        }
+
+        glbType type;
+        type.name     = glbXMLAttributeString(parser, "name");
+        type.requires = glbXMLAttributeString(parser, "requires");
+
+        // The inner content contains the C code, the same as with glbBuildParseTypes().
+        for (;;) {
+            int event = glbXMLNext(parser);
+            if (event == GLB_XML_EVENT_TEXT) {
+                glbXMLAppendText(parser, type.valueC);
+            } else if (event == GLB_XML_EVENT_START_ELEMENT) {
+                if (glbXMLIsElement(parser, "name")) {
+                    std::string name;
+                    glbXMLReadElementText(parser, name);
+                    type.name = name;
+                    type.valueC += name;
+                } else {
+                    if (glbXMLIsElement(parser, "apientry")) {
+                        type.valueC += "APIENTRY";
+                    }
+                    glbXMLSkipElement(parser);
+                }
+            } else {
+                break;
+            }
+        }
+
+        context.types.push_back(std::move(type));
+    }
+
+    return glbXMLResult(parser);
+}
+
+void glbBuildPullParseEnum(glbXMLPullParser &parser, glbEnum &theEnum)
+{
+    theEnum.name  = glbXMLAttributeString(parser, "name");
+    theEnum.value = glbXMLAttributeString(parser, "value");
+    theEnum.type  = glbXMLAttributeString(parser, "type");
+    theEnum.group = glbXMLAttributeString(parser, "group");
+
+    glbXMLSkipElement(parser);
+}
+
+glbResult glbBuildPullParseEnums(glbBuild &context, glbXMLPullParser &parser)
+{
+    glbEnums enums;
+    enums.name            = glbXMLAttribute(parser, "name");
+    enums.namespaceAttrib = glbXMLAttribute(parser, "namespace");
+    enums.group           = glbXMLAttribute(parser, "group");
+    enums.vendor          = glbXMLAttribute(parser, "vendor");
+    enums.type            = glbXMLAttribute(parser, "type");
+    enums.start           = glbXMLAttribute(parser, "start");
+    enums.end             = glbXMLAttribute(parser, "end");
+
+    while (glbXMLNextChildElement(parser)) {
+        if (glbXMLIsElement(parser, "enum")) {
+            glbEnum theEnum;
+            glbBuildPullParseEnum(parser, theEnum);
+            enums.enums.push_back(std::move(theEnum));
+        } else {
+            glbXMLSkipElement(parser);
+        }
+    }
+
+    context.enums.push_back(std::move(enums));
+
+    return glbXMLResult(parser);
+}
+
+glbResult glbBuildPullParseGroups(glbBuild &context, glbXMLPullParser &parser)
+{
+    while (glbXMLNextChildElement(parser)) {
+        if (!glbXMLIsElement(parser, "group")) {
+            glbXMLSkipElement(parser);
+            continue;
+        }
+
+        glbGroup group;
+        group.name = glbXMLAttribute(parser, "name");
+
+        while (glbXMLNextChildElement(parser)) {
+            if (glbXMLIsElement(parser, "enum")) {
+                glbEnum theEnum;
+                glbBuildPullParseEnum(parser, theEnum);
+                group.enums.push_back(std::move(theEnum));
+            } else {
+                glbXMLSkipElement(parser);
+            }
+        }
+
+        context.groups.push_back(std::move(group));
+    }
+
+    return glbXMLResult(parser);
+}
+
+glbResult glbBuildPullParseTypeNamePair(glbXMLPullParser &parser, glbString &typeOut, glbString &typeCOut, glbString &nameOut)
+{
+    // Same rules as glbBuildParseTypeNamePair(). Anything after the <name> tag is ignored.
+    bool foundName = false;
+    std::string type;
+    std::string typeC;
+    std::string name;
+
+    for (;;) {
+        int event = glbXMLNext(parser);
+        if (event == GLB_XML_EVENT_TEXT) {
+            if (!foundName) {
+                glbXMLAppendText(parser, typeC);
+            }
+        } else if (event == GLB_XML_EVENT_START_ELEMENT) {
+            if (foundName) {
+                glbXMLSkipElement(parser);
+            } else if (glbXMLIsElement(parser, "name")) {
+                glbXMLReadElementText(parser, name);
+                foundName = true;
+            } else {
+                bool isType = glbXMLIsElement(parser, "type") || glbXMLIsElement(parser, "ptype");
+                size_t typeOffset = typeC.size();
+                glbXMLReadElementText(parser, typeC);
+                if (isType) {
+                    type.assign(typeC, typeOffset, std::string::npos);
+                }
+            }
+        } else {
+            break;
+        }
+    }
+
+    typeOut  = type;
+    typeCOut = glbTrim(typeC);
+    nameOut  = name;
+
+    return glbXMLResult(parser);
+}
+
+glbResult glbBuildPullParseCommand(glbXMLPullParser &parser, glbCommand &command)
+{
+    while (glbXMLNextChildElement(parser)) {
+        if (glbXMLIsElement(parser, "proto")) {
+            glbBuildPullParseTypeNamePair(parser, command.returnType, command.returnTypeC, command.name);
+        } else if (glbXMLIsElement(parser, "param")) {
+            glbCommandParam param;
+            glbResult result = glbBuildPullParseTypeNamePair(parser, param.type, param.typeC, param.name);
+            if (result != GLB_SUCCESS) {
+                return result;
+            }
+
+            command.params.push_back(std::move(param));
+        } else {
+            if (glbXMLIsElement(parser, "alias")) {
+                command.alias = glbXMLAttributeString(parser, "name");
+            }
+            glbXMLSkipElement(parser);
+        }
+    }
+
+    return glbXMLResult(parser);
+}
+
+glbResult glbBuildPullParseCommands(glbBuild &context, glbXMLPullParser &parser)
+{
+    glbCommands commands;
+    commands.namespaceAttrib = glbXMLAttribute(parser, "namespace");
+
+    while (glbXMLNextChildElement(parser)) {
+        if (glbXMLIsElement(parser, "command")) {
+            glbCommand command;
+            glbResult result = glbBuildPullParseCommand(parser, command);
+            if (result != GLB_SUCCESS) {
+                return result;
+            }
+
+            commands.commands.push_back(std::move(command));
+        } else {
+            glbXMLSkipElement(parser);
+        }
+    }
+
+    context.commands.push_back(std::move(commands));
+
+    return glbXMLResult(parser);
+}
+
+glbResult glbBuildPullParseRequire(glbXMLPullParser &parser, glbRequire &require)
+{
+    require.profile = glbXMLAttribute(parser, "profile");
+    require.api     = glbXMLAttribute(parser, "api");
+
+    while (glbXMLNextChildElement(parser)) {
+        if (glbXMLIsElement(parser, "type")) {
+            require.types.push_back(glbXMLAttributeString(parser, "name"));
+        } else if (glbXMLIsElement(parser, "enum")) {
+            require.enums.push_back(glbXMLAttributeString(parser, "name"));
+        } else if (glbXMLIsElement(parser, "command")) {
+            require.commands.push_back(glbXMLAttributeString(parser, "name"));
+        }
+
+        glbXMLSkipElement(parser);
+    }
+
+    return glbXMLResult(parser);
+}
+
+// Parses the <require> and <remove> children of a <feature> or <extension>. "removes" can be NULL for extensions.
+glbResult glbBuildPullParseRequires(glbXMLPullParser &parser, std::vector<glbRequire> &requires, std::vector<glbRequire>* removes)
+{
+    while (glbXMLNextChildElement(parser)) {
+        if (glbXMLIsElement(parser, "require") || (removes != NULL && glbXMLIsElement(parser, "remove"))) {
+            std::vector<glbRequire> &list = glbXMLIsElement(parser, "require") ? requires : *removes;
+
+            glbRequire require;
+            glbResult result = glbBuildPullParseRequire(parser, require);
+            if (result != GLB_SUCCESS) {
+                return result;
+            }
+
+            list.push_back(std::move(require));
+        } else {
+            glbXMLSkipElement(parser);
+        }
+    }
+
+    return glbXMLResult(parser);
+}
+
+glbResult glbBuildPullParseFeature(glbBuild &context, glbXMLPullParser &parser)
+{
+    glbFeature feature;
+    feature.api    = glbXMLAttribute(parser, "api");
+    feature.name   = glbXMLAttribute(parser, "name");
+    feature.number = glbXMLAttribute(parser, "number");
+
+    glbResult result = glbBuildPullParseRequires(parser, feature.requires, &feature.removes);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    context.features.push_back(std::move(feature));
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildPullParseExtensions(glbBuild &context, glbXMLPullParser &parser)
+{
+    while (glbXMLNextChildElement(parser)) {
+        if (!glbXMLIsElement(parser, "extension")) {
+            glbXMLSkipElement(parser);
+            continue;
+        }
+
+        glbExtension extension;
+        extension.name      = glbXMLAttribute(parser, "name");
+        extension.supported = glbXMLAttribute(parser, "supported");
+
+        glbResult result = glbBuildPullParseRequires(parser, extension.requires, NULL);
+        if (result != GLB_SUCCESS) {
+            return result;
+        }
+
+        context.extensions.push_back(std::move(extension));
+    }
+
+    return glbXMLResult(parser);
+}
+
+glbResult glbBuildPullParseRegistry(glbBuild &context, glbXMLPullParser &parser)
+{
+    // The root node is the <registry> node.
+    if (!glbXMLNextChildElement(parser)) {
+        printf("Failed to retrieve root node.\n");
+        return GLB_ERROR;
+    }
+
+    if (!glbXMLIsElement(parser, "registry")) {
+        printf("Unexpected root node. Expecting \"registry\", but got \"%.*s\"", (int)parser.name.length, parser.name.p);
+        return GLB_ERROR;
+    }
+
+    while (glbXMLNextChildElement(parser)) {
+        glbResult result = GLB_SUCCESS;
+
+        if (glbXMLIsElement(parser, "types")) {
+            result = glbBuildPullParseTypes(context, parser);
+        } else if (glbXMLIsElement(parser, "groups")) {
+            result = glbBuildPullParseGroups(context, parser);
+        } else if (glbXMLIsElement(parser, "enums")) {
+            result = glbBuildPullParseEnums(context, parser);
+        } else if (glbXMLIsElement(parser, "commands")) {
+            result = glbBuildPullParseCommands(context, parser);
+        } else if (glbXMLIsElement(parser, "feature")) {
+            result = glbBuildPullParseFeature(context, parser);
+        } else if (glbXMLIsElement(parser, "extensions")) {
+            result = glbBuildPullParseExtensions(context, parser);
+        } else {
+            glbXMLSkipElement(parser);
+        }
+
+        if (result != GLB_SUCCESS) {
+            return result;
+        }
+    }
+
+    return glbXMLResult(parser);
+}
+
+glbResult glbBuildLoadXMLFile(glbBuild &context, const char* filePath)
+{
+    glbMappedFile file;
+    glbResult result = glbMapFile(filePath, &file);
+    if (result != GLB_SUCCESS) {
+        printf("Failed to open %s\n", filePath);
+        return result;
+    }
+
+    glbXMLPullParser parser;
+    glbXMLInit(parser, file.pData, file.size);
+
+    result = glbBuildPullParseRegistry(context, parser);
+    if (result != GLB_SUCCESS) {
+        printf("Failed to parse %s\n", filePath);
+    }
+
+    glbUnmapFile(&file);
+    return result;
+}
+
+template <typename T>
+void glbAppendMoved(std::vector<T> &dst, std::vector<T> &src)
+{
+    dst.insert(dst.end(), std::make_move_iterator(src.begin()), std::make_move_iterator(src.end()));
+    src.clear();
+}
+
+// Appends the registry items of "src" to "context". Must be done before glbBuildIndexRegistry().
+void glbBuildMerge(glbBuild &context, glbBuild &src)
+{
+    glbAppendMoved(context.types,      src.types);
+    glbAppendMoved(context.groups,     src.groups);
+    glbAppendMoved(context.enums,      src.enums);
+    glbAppendMoved(context.commands,   src.commands);
+    glbAppendMoved(context.features,   src.features);
+    glbAppendMoved(context.extensions, src.extensions);
+}
+
+// Loads a list of XML files. Each file is parsed on its own thread into a separate glbBuild object. These are then merged into "context"
+// in the order they are specified in "filePaths" so the result is the same as loading them one after the other. When "useDOM" is set the
+// reference tinyxml2 loader is used instead of the pull parser.
+glbResult glbBuildLoadXMLFiles(glbBuild &context, const char** filePaths, size_t fileCount, bool useDOM)
+{
+    std::vector<glbBuild> partials(fileCount);
+    std::vector<glbResult> results(fileCount, GLB_SUCCESS);
+    std::vector<std::thread> threads;
+
+    for (size_t iFile = 0; iFile < fileCount; ++iFile) {
+        threads.emplace_back([&partials, &results, filePaths, iFile, useDOM]() {
+            if (useDOM) {
+                results[iFile] = glbBuildLoadXMLFileDOM(partials[iFile], filePaths[iFile]);
+            } else {
+                results[iFile] = glbBuildLoadXMLFile(partials[iFile], filePaths[iFile]);
+            }
+        });
+    }
+
+    for (size_t iThread = 0; iThread < threads.size(); ++iThread) {
+        threads[iThread].join();
+    }
+
+    for (size_t iFile = 0; iFile < fileCount; ++iFile) {
+        if (results[iFile] != GLB_SUCCESS) {
+            return results[iFile];
+        }
+
+        glbBuildMerge(context, partials[iFile]);
+    }
+
+    return GLB_SUCCESS;
+}
+
+
+// Registry comparison. Used by --verify-parser to check the pull parser against the DOM loader.
+bool glbIsEqual(const std::string &a, const std::string &b)
+{
+    return a == b;
+}
+
+bool glbIsEqual(glbString a, glbString b)
+{
+    return a == b;
+}
+
+bool glbIsEqual(const glbType &a, const glbType &b)
+{
+    return a.name == b.name && a.valueC == b.valueC && a.requires == b.requires;
+}
+
+bool glbIsEqual(const glbEnum &a, const glbEnum &b)
+{
+    return a.name == b.name && a.value == b.value && a.type == b.type && a.group == b.group;
+}
+
+template <typename T>
+bool glbIsEqual(const std::vector<T> &a, const std::vector<T> &b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (!glbIsEqual(a[i], b[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool glbIsEqual(const glbGroup &a, const glbGroup &b)
+{
+    return a.name == b.name && glbIsEqual(a.enums, b.enums);
+}
+
+bool glbIsEqual(const glbEnums &a, const glbEnums &b)
+{
+    return
+        a.name   == b.name   && a.namespaceAttrib == b.namespaceAttrib && a.group == b.group && a.vendor == b.vendor &&
+        a.type   == b.type   && a.start           == b.start           && a.end   == b.end   &&
+        glbIsEqual(a.enums, b.enums);
+}
+
+bool glbIsEqual(const glbCommandParam &a, const glbCommandParam &b)
+{
+    return a.type == b.type && a.typeC == b.typeC && a.name == b.name && a.group == b.group;
+}
+
+bool glbIsEqual(const glbCommand &a, const glbCommand &b)
+{
+    return
+        a.returnType == b.returnType && a.returnTypeC == b.returnTypeC && a.name == b.name && a.alias == b.alias &&
+        glbIsEqual(a.params, b.params);
+}
+
+bool glbIsEqual(const glbCommands &a, const glbCommands &b)
+{
+    return a.namespaceAttrib == b.namespaceAttrib && glbIsEqual(a.commands, b.commands);
+}
+
+bool glbIsEqual(const glbRequire &a, const glbRequire &b)
+{
+    return a.profile == b.profile && a.api == b.api && glbIsEqual(a.types, b.types) && glbIsEqual(a.enums, b.enums) && glbIsEqual(a.commands, b.commands);
+}
+
+bool glbIsEqual(const glbFeature &a, const glbFeature &b)
+{
+    return a.api == b.api && a.name == b.name && a.number == b.number && glbIsEqual(a.requires, b.requires) && glbIsEqual(a.removes, b.removes);
+}
+
+bool glbIsEqual(const glbExtension &a, const glbExtension &b)
+{
+    return a.name == b.name && a.supported == b.supported && glbIsEqual(a.requires, b.requires);
+}
+
+template <typename T>
+bool glbBuildCompareList(const char* listName, const std::vector<T> &a, const std::vector<T> &b)
+{
+    if (a.size() != b.size()) {
+        printf("Registry mismatch: %s has %d items versus %d.\n", listName, (int)a.size(), (int)b.size());
+        return false;
+    }
+
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (!glbIsEqual(a[i], b[i])) {
+            printf("Registry mismatch: %s[%d].\n", listName, (int)i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Returns true if both registries contain exactly the same items in the same order. The first difference is printed.
+bool glbBuildCompareRegistries(const glbBuild &a, const glbBuild &b)
+{
+    return
+        glbBuildCompareList("types",      a.types,      b.types)    &&
+        glbBuildCompareList("groups",     a.groups,     b.groups)   &&
+        glbBuildCompareList("enums",      a.enums,      b.enums)    &&
+        glbBuildCompareList("commands",   a.commands,   b.commands) &&
+        glbBuildCompareList("features",   a.features,   b.features) &&
+        glbBuildCompareList("extensions", a.extensions, b.extensions);
+}
+
+
+// Binary cache of the parsed registry. This lets the build tool skip parsing the XML files when they haven't changed, and skip generating
+// the output file entirely when the template hasn't changed either and the output file is still the one we generated last time.
+//
+// Layout (little or big endian, matching the machine that wrote it; the cache is not meant to be shared between machines):
+//   uint32  magic ("GLBC")
+//   uint32  version (GLB_BUILD_CACHE_VERSION)
+//   uint64  registry hash (the XML files)
+//   uint64  generator hash (the template, the build of this tool and its command line)
+//   uint64  output hash (the generated file)
+//   ...     the string table, which is the string pool at the time of writing. Each string is a uint32 length followed by the characters.
+//   ...     the registry, with interned strings stored as a uint32 index into the string table, and lists as a uint32 count followed by the
+//           items.
+//
+// Bump GLB_BUILD_CACHE_VERSION whenever the registry structures change.
+#define GLB_BUILD_CACHE_MAGIC   0x43424C47  /* "GLBC" */
+#define GLB_BUILD_CACHE_VERSION 4
+#define GLB_BUILD_ID            __DATE__ " " __TIME__
+
+struct glbBuildCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t registryHash;
+    uint64_t generatorHash;
+    uint64_t outputHash;
+};
+
+void glbCacheWrite(std::string &out, uint32_t value)
+{
+    out.append((const char*)&value, sizeof(value));
+}
+
+void glbCacheWrite(std::string &out, const std::string &value)
+{
+    glbCacheWrite(out, (uint32_t)value.size());
+    out.append(value);
+}
+
+void glbCacheWrite(std::string &out, glbString value)
+{
+    glbCacheWrite(out, value.id);
+}
+
+void glbCacheWriteStringPool(std::string &out)
+{
+    uint32_t count;
+    {
+        std::lock_guard<std::mutex> guard(g_StringPool.lock);
+        count = g_StringPool.count;
+    }
+
+    glbCacheWrite(out, count);
+    for (uint32_t id = 0; id < count; ++id) {
+        glbCacheWrite(out, glbStringPoolGet(id));
+    }
+}
+
+template <typename T>
+void glbCacheWrite(std::string &out, const std::vector<T> &list)
+{
+    glbCacheWrite(out, (uint32_t)list.size());
+    for (size_t i = 0; i < list.size(); ++i) {
+        glbCacheWrite(out, list[i]);
+    }
+}
+
+void glbCacheWrite(std::string &out, const glbType &type)
+{
+    glbCacheWrite(out, type.name);
+    glbCacheWrite(out, type.valueC);
+    glbCacheWrite(out, type.requires);
+}
+
+void glbCacheWrite(std::string &out, const glbEnum &theEnum)
+{
+    glbCacheWrite(out, theEnum.name);
+    glbCacheWrite(out, theEnum.value);
+    glbCacheWrite(out, theEnum.type);
+    glbCacheWrite(out, theEnum.group);
+}
+
+void glbCacheWrite(std::string &out, const glbGroup &group)
+{
+    glbCacheWrite(out, group.name);
+    glbCacheWrite(out, group.enums);
+}
+
+void glbCacheWrite(std::string &out, const glbEnums &enums)
+{
+    glbCacheWrite(out, enums.name);
+    glbCacheWrite(out, enums.namespaceAttrib);
+    glbCacheWrite(out, enums.group);
+    glbCacheWrite(out, enums.vendor);
+    glbCacheWrite(out, enums.type);
+    glbCacheWrite(out, enums.start);
+    glbCacheWrite(out, enums.end);
+    glbCacheWrite(out, enums.enums);
+}
+
+void glbCacheWrite(std::string &out, const glbCommandParam &param)
+{
+    glbCacheWrite(out, param.type);
+    glbCacheWrite(out, param.typeC);
+    glbCacheWrite(out, param.name);
+    glbCacheWrite(out, param.group);
+}
+
+void glbCacheWrite(std::string &out, const glbCommand &command)
+{
+    glbCacheWrite(out, command.returnType);
+    glbCacheWrite(out, command.returnTypeC);
+    glbCacheWrite(out, command.name);
+    glbCacheWrite(out, command.params);
+    glbCacheWrite(out, command.alias);
+}
+
+void glbCacheWrite(std::string &out, const glbCommands &commands)
+{
+    glbCacheWrite(out, commands.namespaceAttrib);
+    glbCacheWrite(out, commands.commands);
+}
+
+void glbCacheWrite(std::string &out, const glbRequire &require)
+{
+    glbCacheWrite(out, require.profile);
+    glbCacheWrite(out, require.api);
+    glbCacheWrite(out, require.types);
+    glbCacheWrite(out, require.enums);
+    glbCacheWrite(out, require.commands);
+}
+
+void glbCacheWrite(std::string &out, const glbFeature &feature)
+{
+    glbCacheWrite(out, feature.api);
+    glbCacheWrite(out, feature.name);
+    glbCacheWrite(out, feature.number);
+    glbCacheWrite(out, feature.requires);
+    glbCacheWrite(out, feature.removes);
+}
+
+void glbCacheWrite(std::string &out, const glbExtension &extension)
+{
+    glbCacheWrite(out, extension.name);
+    glbCacheWrite(out, extension.supported);
+    glbCacheWrite(out, extension.requires);
+}
+
+// Reads from a cache file. Reads past the end set "failed" and return zeroed data so the functions below don't need to check every read.
+struct glbCacheReader
+{
+    const char* pCursor;
+    const char* pEnd;
+    bool failed;
+    std::vector<glbString> strings;    // The string table, interned into this process' pool.
+};
+
+void glbCacheRead(glbCacheReader &in, uint32_t &value)
+{
+    if ((size_t)(in.pEnd - in.pCursor) < sizeof(value)) {
+        in.failed  = true;
+        in.pCursor = in.pEnd;
+        value = 0;
+        return;
+    }
+
+    memcpy(&value, in.pCursor, sizeof(value));
+    in.pCursor += sizeof(value);
+}
+
+void glbCacheRead(glbCacheReader &in, std::string &value)
+{
+    uint32_t length;
+    glbCacheRead(in, length);
+
+    if ((size_t)(in.pEnd - in.pCursor) < length) {
+        in.failed  = true;
+        in.pCursor = in.pEnd;
+        length = 0;
+    }
+
+    value.assign(in.pCursor, length);
+    in.pCursor += length;
+}
+
+void glbCacheRead(glbCacheReader &in, glbString &value)
+{
+    uint32_t index;
+    glbCacheRead(in, index);
+
+    if (index >= in.strings.size()) {
+        in.failed = true;
+        value = glbString();
+        return;
+    }
+
+    value = in.strings[index];
+}
+
+template <typename T>
+void glbCacheRead(glbCacheReader &in, std::vector<T> &list)
+{
+    uint32_t count;
+    glbCacheRead(in, count);
+
+    // Every item takes up at least 4 bytes which puts an upper bound on the count of a valid file.
+    if (count > (size_t)(in.pEnd - in.pCursor) / 4) {
+        in.failed  = true;
+        in.pCursor = in.pEnd;
+        count = 0;
+    }
+
+    list.resize(count);
+    for (size_t i = 0; i < list.size(); ++i) {
+        glbCacheRead(in, list[i]);
+    }
+}
+
+void glbCacheRead(glbCacheReader &in, glbType &type)
+{
+    glbCacheRead(in, type.name);
+    glbCacheRead(in, type.valueC);
+    glbCacheRead(in, type.requires);
+}
+
+void glbCacheRead(glbCacheReader &in, glbEnum &theEnum)
+{
+    glbCacheRead(in, theEnum.name);
+    glbCacheRead(in, theEnum.value);
+    glbCacheRead(in, theEnum.type);
+    glbCacheRead(in, theEnum.group);
+}
+
+void glbCacheRead(glbCacheReader &in, glbGroup &group)
+{
+    glbCacheRead(in, group.name);
+    glbCacheRead(in, group.enums);
+}
+
+void glbCacheRead(glbCacheReader &in, glbEnums &enums)
+{
+    glbCacheRead(in, enums.name);
+    glbCacheRead(in, enums.namespaceAttrib);
+    glbCacheRead(in, enums.group);
+    glbCacheRead(in, enums.vendor);
+    glbCacheRead(in, enums.type);
+    glbCacheRead(in, enums.start);
+    glbCacheRead(in, enums.end);
+    glbCacheRead(in, enums.enums);
+}
+
+void glbCacheRead(glbCacheReader &in, glbCommandParam &param)
+{
+    glbCacheRead(in, param.type);
+    glbCacheRead(in, param.typeC);
+    glbCacheRead(in, param.name);
+    glbCacheRead(in, param.group);
+}
+
+void glbCacheRead(glbCacheReader &in, glbCommand &command)
+{
+    glbCacheRead(in, command.returnType);
+    glbCacheRead(in, command.returnTypeC);
+    glbCacheRead(in, command.name);
+    glbCacheRead(in, command.params);
+    glbCacheRead(in, command.alias);
+}
+
+void glbCacheRead(glbCacheReader &in, glbCommands &commands)
+{
+    glbCacheRead(in, commands.namespaceAttrib);
+    glbCacheRead(in, commands.commands);
+}
+
+void glbCacheRead(glbCacheReader &in, glbRequire &require)
+{
+    glbCacheRead(in, require.profile);
+    glbCacheRead(in, require.api);
+    glbCacheRead(in, require.types);
+    glbCacheRead(in, require.enums);
+    glbCacheRead(in, require.commands);
+}
+
+void glbCacheRead(glbCacheReader &in, glbFeature &feature)
+{
+    glbCacheRead(in, feature.api);
+    glbCacheRead(in, feature.name);
+    glbCacheRead(in, feature.number);
+    glbCacheRead(in, feature.requires);
+    glbCacheRead(in, feature.removes);
+}
+
+void glbCacheRead(glbCacheReader &in, glbExtension &extension)
+{
+    glbCacheRead(in, extension.name);
+    glbCacheRead(in, extension.supported);
+    glbCacheRead(in, extension.requires);
+}
+
+// Serializes the registry. The registry needs to be serialized before glbBuildApplySelection() since the cache always holds the whole
+// registry. Space is left at the start of the data for the header which is filled in by glbBuildSaveCache().
+void glbBuildSerializeRegistry(const glbBuild &context, std::string &data)
+{
+    data.assign(sizeof(glbBuildCacheHeader), '\0');
+
+    glbCacheWriteStringPool(data);
+    glbCacheWrite(data, context.types);
+    glbCacheWrite(data, context.groups);
+    glbCacheWrite(data, context.enums);
+    glbCacheWrite(data, context.commands);
+    glbCacheWrite(data, context.features);
+    glbCacheWrite(data, context.extensions);
+}
+
+glbResult glbBuildSaveCache(std::string &data, const glbBuildCacheHeader &header, const char* filePath)
+{
+    memcpy(&data[0], &header, sizeof(header));
+    return glbOpenAndWriteFile(filePath, data.data(), data.size());
+}
+
+// Opens a cache file and reads its header. On success the file is left mapped so the registry can be read with glbBuildLoadCacheRegistry()
+// if required. The file must be unmapped with glbUnmapFile().
+glbResult glbBuildOpenCache(const char* filePath, glbMappedFile* pFile, glbBuildCacheHeader* pHeader)
+{
+    glbResult result = glbMapFile(filePath, pFile);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    if (pFile->size < sizeof(*pHeader)) {
+        glbUnmapFile(pFile);
+        return GLB_ERROR;
+    }
+
+    memcpy(pHeader, pFile->pData, sizeof(*pHeader));
+    if (pHeader->magic != GLB_BUILD_CACHE_MAGIC || pHeader->version != GLB_BUILD_CACHE_VERSION) {
+        glbUnmapFile(pFile);
+        return GLB_ERROR;
+    }
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildLoadCacheRegistry(glbBuild &context, const glbMappedFile &file)
+{
+    glbCacheReader in;
+    in.pCursor = file.pData + sizeof(glbBuildCacheHeader);
+    in.pEnd    = file.pData + file.size;
+    in.failed  = false;
+
+    std::vector<std::string> strings;
+    glbCacheRead(in, strings);
+    in.strings.reserve(strings.size());
+    for (const std::string &str : strings) {
+        in.strings.push_back(glbString(str));
+    }
+
+    glbCacheRead(in, context.types);
+    glbCacheRead(in, context.groups);
+    glbCacheRead(in, context.enums);
+    glbCacheRead(in, context.commands);
+    glbCacheRead(in, context.features);
+    glbCacheRead(in, context.extensions);
+
+    if (in.failed || in.pCursor != in.pEnd) {
+        context.types.clear();
+        context.groups.clear();
+        context.enums.clear();
+        context.commands.clear();
+        context.features.clear();
+        context.extensions.clear();
+        return GLB_ERROR;
+    }
+
+    return GLB_SUCCESS;
+}
+
+bool glbDoesExtensionBelongToVendor(const std::string &extensionName, const std::string &vendor)
+{
+    return extensionName.find("_" + vendor + "_") != std::string::npos;
+}
+
+bool glbIsExtensionBlackListed(const char* extensionName)
+{
+    for (auto blacklistedExtension : g_BlacklistedExtensions) {
+        if (strcmp(blacklistedExtension, extensionName) == 0) {
+            return true;
+        }
+    }
+
+    for (auto vendor : g_BlacklistedExtensionVendors) {
+        if (glbDoesExtensionBelongToVendor(extensionName, vendor)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool glbBuildIsCommandIgnored(const char* commandName)
+{
+    // The following commands should not be included in anything as they are not strictly OpenGL related.
+    static const char* ignoredCommands[] = {
+        "ChoosePixelFormat",
+        "DescribePixelFormat",
+        "GetEnhMetaFilePixelFormat",
+        "GetPixelFormat",
+        "SetPixelFormat",
+        "SwapBuffers",
+        "wglUseFontBitmaps",
+        "wglUseFontOutlines",
+    };
+
+    for (size_t i = 0; i < sizeof(ignoredCommands)/sizeof(ignoredCommands[0]); ++i) {
+        if (strcmp(ignoredCommands[i], commandName) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+// Checks if an item is in a '|' or ',' separated list such as the "supported" attribute of an extension.
+bool glbIsInList(const std::string &list, const std::string &item)
+{
+    size_t beg = 0;
+    for (;;) {
+        size_t end = list.find_first_of("|,", beg);
+        if (list.compare(beg, (end == std::string::npos) ? std::string::npos : end - beg, item) == 0) {
+            return true;
+        }
+
+        if (end == std::string::npos) {
+            return false;
+        }
+
+        beg = end + 1;
+    }
+}
+
+// Converts a feature number like "4.5" to something that can be compared, like 450. This is the same format as GLBIND_MAX_GL_VERSION.
+int glbParseVersionNumber(const std::string &number)
+{
+    int major = 0;
+    int minor = 0;
+    sscanf(number.c_str(), "%d.%d", &major, &minor);
+
+    return major*100 + minor*10;
+}
+
+// Whether or not an extension is output with the extensions for the main API. WGL and GLX extensions are output separately.
+bool glbBuildIsMainAPIExtension(const glbBuild &context, const glbExtension &extension)
+{
+    if (context.selection.api == "gl") {
+        return extension.supported == "gl" || glbContains(extension.supported, "gl|") || glbContains(extension.supported, "glcore");
+    }
+
+    return glbIsInList(extension.supported, context.selection.api);
+}
+
+// The full header includes the <require> blocks for every API and profile, and ignores <remove> blocks. Blocks are only filtered once a
+// profile or an API other than "gl" has been selected.
+bool glbBuildIsRequireSelected(const glbBuildSelection &selection, const glbRequire &require)
+{
+    if (selection.profile.empty() && selection.api == "gl") {
+        return true;
+    }
+
+    return (require.api.empty() || require.api == selection.api) && (require.profile.empty() || require.profile == selection.profile);
+}
+
+void glbRemoveNames(std::vector<glbString> &names, const std::unordered_set<glbString> &namesToRemove)
+{
+    names.erase(std::remove_if(names.begin(), names.end(), [&](glbString name) { return namesToRemove.count(name) > 0; }), names.end());
+}
+
+// Trims the registry down to what's been selected. Features and extensions that aren't selected are removed, as are <require> blocks
+// for other APIs and profiles. Anything removed from the selected profile with a <remove> block is removed from the features that would
+// otherwise have required it. Must be called before glbBuildIndexRegistry().
+glbResult glbBuildApplySelection(glbBuild &context, const glbBuildSelection &selection)
+{
+    context.selection = selection;
+
+    if (!selection.profile.empty() && selection.profile != "core" && selection.profile != "compatibility") {
+        printf("Unknown profile \"%s\". Expecting \"core\" or \"compatibility\".\n", selection.profile.c_str());
+        return GLB_INVALID_ARGS;
+    }
+
+    // Features.
+    int maxVersion = selection.maxVersion.empty() ? INT_MAX : glbParseVersionNumber(selection.maxVersion);
+    std::unordered_set<glbString> removedTypes;
+    std::unordered_set<glbString> removedEnums;
+    std::unordered_set<glbString> removedCommands;
+    std::vector<glbFeature> features;
+    bool hasAPI = false;
+
+    for (size_t iFeature = 0; iFeature < context.features.size(); ++iFeature) {
+        glbFeature &feature = context.features[iFeature];
+
+        bool isSelected;
+        if (feature.api == "wgl") {
+            isSelected = selection.wgl;
+        } else if (feature.api == "glx") {
+            isSelected = selection.glx;
+        } else {
+            isSelected = (feature.api == selection.api && glbParseVersionNumber(feature.number) <= maxVersion);
+            hasAPI = hasAPI || (feature.api == selection.api);
+        }
+
+        if (!isSelected) {
+            continue;
+        }
+
+        feature.requires.erase(std::remove_if(feature.requires.begin(), feature.requires.end(), [&](const glbRequire &require) { return !glbBuildIsRequireSelected(selection, require); }), feature.requires.end());
+
+        for (size_t iRemove = 0; iRemove < feature.removes.size(); ++iRemove) {
+            const glbRequire &remove = feature.removes[iRemove];
+            if (!selection.profile.empty() && glbBuildIsRequireSelected(selection, remove)) {
+                removedTypes.insert(remove.types.begin(), remove.types.end());
+                removedEnums.insert(remove.enums.begin(), remove.enums.end());
+                removedCommands.insert(remove.commands.begin(), remove.commands.end());
+            }
+        }
+
+        features.push_back(std::move(feature));
+    }
+
+    if (!hasAPI) {
+        printf("The registry does not have any features for the \"%s\" API.\n", selection.api.c_str());
+        return GLB_INVALID_ARGS;
+    }
+
+    for (size_t iFeature = 0; iFeature < features.size(); ++iFeature) {
+        for (size_t iRequire = 0; iRequire < features[iFeature].requires.size(); ++iRequire) {
+            glbRequire &require = features[iFeature].requires[iRequire];
+            glbRemoveNames(require.types,    removedTypes);
+            glbRemoveNames(require.enums,    removedEnums);
+            glbRemoveNames(require.commands, removedCommands);
+        }
+    }
+
+    context.features = std::move(features);
+
+
+    // Extensions. In the core profile, extensions for "gl" need to be marked as supported by "glcore".
+    std::unordered_set<std::string> unusedExtensions = selection.extensions;
+    std::vector<glbExtension> extensions;
+
+    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
+        glbExtension &extension = context.extensions[iExtension];
+
+        bool isListed = selection.allExtensions || selection.extensions.count(extension.name) > 0;
+        unusedExtensions.erase(extension.name);
+
+        bool isSelected;
+        if (glbIsInList(extension.supported, "wgl")) {
+            isSelected = selection.wgl && isListed;
+        } else if (glbIsInList(extension.supported, "glx")) {
+            isSelected = selection.glx && isListed;
+        } else if (selection.api == "gl" && selection.profile == "core") {
+            isSelected = isListed && glbIsInList(extension.supported, "glcore");
+        } else {
+            isSelected = isListed && glbBuildIsMainAPIExtension(context, extension);
+        }
+
+        if (!isSelected) {
+            if (isListed && !selection.allExtensions) {
+                printf("Warning: %s is not supported by the selected API, profile or platforms.\n", extension.name.c_str());
+            }
+            continue;
+        }
+
+        extension.requires.erase(std::remove_if(extension.requires.begin(), extension.requires.end(), [&](const glbRequire &require) { return !glbBuildIsRequireSelected(selection, require); }), extension.requires.end());
+        extensions.push_back(std::move(extension));
+    }
+
+    if (!unusedExtensions.empty()) {
+        for (auto name = unusedExtensions.begin(); name != unusedExtensions.end(); ++name) {
+            printf("Unknown extension: %s\n", name->c_str());
+        }
+        return GLB_INVALID_ARGS;
+    }
+
+    context.extensions = std::move(extensions);
+
+    return GLB_SUCCESS;
+}
+
+const char* glbBuildGetSectionPlatform(int section)
+{
+    if (section == GLB_BUILD_SECTION_WGL_FEATURES || section == GLB_BUILD_SECTION_WGL_EXTENSIONS) {
+        return "GLBIND_WGL";
+    }
+    if (section == GLB_BUILD_SECTION_GLX_FEATURES || section == GLB_BUILD_SECTION_GLX_EXTENSIONS) {
+        return "GLBIND_GLX";
+    }
+
+    return NULL;
+}
+
+std::string glbAndConditions(const std::string &a, const std::string &b)
+{
+    if (a.empty()) {
+        return b;
+    }
+    if (b.empty()) {
+        return a;
+    }
+
+    return a + " && " + b;
+}
+
+void glbBuildAddBlock(glbBuild &context, const std::string &name, const std::vector<glbRequire> &requires, int section, const std::string &condition)
+{
+    glbBuildBlock block;
+    block.name      = name;
+    block.pRequires = &requires;
+    block.section   = section;
+    block.condition = condition;
+    context.blocks.push_back(block);
+}
+
+void glbBuildAddFeatureBlocks(glbBuild &context, const char* api, int section)
+{
+    bool isFirst = true;
+    for (size_t iFeature = 0; iFeature < context.features.size(); ++iFeature) {
+        const glbFeature &feature = context.features[iFeature];
+        if (feature.api != api) {
+            continue;
+        }
+
+        // Only the main API can be limited to a version. The first version is always included.
+        std::string condition;
+        if (section == GLB_BUILD_SECTION_FEATURES && !isFirst) {
+            condition = "!defined(GLBIND_MAX_GL_VERSION) || GLBIND_MAX_GL_VERSION >= " + std::to_string(glbParseVersionNumber(feature.number));
+        }
+
+        glbBuildAddBlock(context, feature.name, feature.requires, section, condition);
+        isFirst = false;
+    }
+}
+
+void glbBuildAddExtensionBlock(glbBuild &context, const glbExtension &extension, int section)
+{
+    std::string condition = "!defined(GLBIND_ONLY_LISTED_EXTENSIONS) || defined(GLBIND_ENABLE_" + extension.name + ")";
+
+    // Extensions that can't be used with a core profile context are part of the compatibility profile.
+    if (section == GLB_BUILD_SECTION_EXTENSIONS && context.selection.api == "gl" && !glbIsInList(extension.supported, "glcore")) {
+        condition = "(" + condition + ") && !defined(GLBIND_NO_COMPATIBILITY)";
+    }
+
+    glbBuildAddBlock(context, extension.name, extension.requires, section, condition);
+}
+
+void glbBuildAddBlockReference(std::unordered_map<glbString, std::vector<size_t>> &blocksByName, glbString name, size_t iBlock)
+{
+    std::vector<size_t> &blocks = blocksByName[name];
+    if (blocks.empty() || blocks.back() != iBlock) {
+        blocks.push_back(iBlock);
+    }
+}
+
+// A command is included if any of the blocks requiring it are included.
+std::string glbBuildGetCommandCondition(const glbBuild &context, glbString commandName, const std::vector<size_t> &blocks)
+{
+    std::vector<std::string> terms;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        const glbBuildBlock &block = context.blocks[blocks[i]];
+        bool isCompatibility = (block.section == GLB_BUILD_SECTION_FEATURES && context.compatibilityNames.count(commandName) > 0);
+
+        if (block.condition.empty() && !isCompatibility) {
+            return "";
+        }
+
+        std::string term;
+        if (!block.condition.empty()) {
+            term = "defined(GLBIND_HAS_" + block.name + ")";
+        }
+        if (isCompatibility) {
+            term = glbAndConditions(term, "!defined(GLBIND_NO_COMPATIBILITY)");
+        }
+
+        if (std::find(terms.begin(), terms.end(), term) == terms.end()) {
+            terms.push_back(term);
+        }
+    }
+
+    if (terms.size() == 1) {
+        return terms[0];
+    }
+
+    std::string condition;
+    for (size_t iTerm = 0; iTerm < terms.size(); ++iTerm) {
+        if (iTerm > 0) {
+            condition += " || ";
+        }
+
+        if (glbContains(terms[iTerm], "&&")) {
+            condition += "(" + terms[iTerm] + ")";
+        } else {
+            condition += terms[iTerm];
+        }
+    }
+
+    return condition;
+}
+
+// Builds the list of blocks in the order they're output and works out which blocks need each type and command. Commands and types
+// can be required by more than one block, in which case they need to be available if any of those blocks are included.
+void glbBuildIndexBlocks(glbBuild &context)
+{
+    context.blocks.clear();
+    context.typeBlocks.clear();
+    context.commandBlocks.clear();
+    context.commandConditions.clear();
+    context.compatibilityNames.clear();
+
+    glbBuildAddFeatureBlocks(context, context.selection.api.c_str(), GLB_BUILD_SECTION_FEATURES);
+    glbBuildAddFeatureBlocks(context, "wgl", GLB_BUILD_SECTION_WGL_FEATURES);
+    glbBuildAddFeatureBlocks(context, "glx", GLB_BUILD_SECTION_GLX_FEATURES);
+
+    // Extensions are done in separate passes for each API so they're grouped by platform.
+    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
+        const glbExtension &extension = context.extensions[iExtension];
+        if (!glbIsExtensionBlackListed(extension.name.c_str()) && glbBuildIsMainAPIExtension(context, extension)) {
+            glbBuildAddExtensionBlock(context, extension, GLB_BUILD_SECTION_EXTENSIONS);
+        }
+    }
+
+    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
+        const glbExtension &extension = context.extensions[iExtension];
+        if (!glbIsExtensionBlackListed(extension.name.c_str()) && glbContains(extension.supported, "wgl")) {
+            glbBuildAddExtensionBlock(context, extension, GLB_BUILD_SECTION_WGL_EXTENSIONS);
+        }
+    }
+
+    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
+        const glbExtension &extension = context.extensions[iExtension];
+        if (!glbIsExtensionBlackListed(extension.name.c_str()) && glbContains(extension.supported, "glx")) {
+            glbBuildAddExtensionBlock(context, extension, GLB_BUILD_SECTION_GLX_EXTENSIONS);
+        }
+    }
+
+    // Anything removed from the core profile, or only required by the compatibility profile, is only included when GLBIND_NO_COMPATIBILITY
+    // is not defined.
+    for (size_t iFeature = 0; iFeature < context.features.size(); ++iFeature) {
+        const glbFeature &feature = context.features[iFeature];
+        if (feature.api != context.selection.api) {
+            continue;
+        }
+
+        for (size_t iRequire = 0; iRequire < feature.requires.size(); ++iRequire) {
+            const glbRequire &require = feature.requires[iRequire];
+            if (require.profile == "compatibility") {
+                context.compatibilityNames.insert(require.enums.begin(), require.enums.end());
+                context.compatibilityNames.insert(require.commands.begin(), require.commands.end());
+            }
+        }
+
+        for (size_t iRemove = 0; iRemove < feature.removes.size(); ++iRemove) {
+            const glbRequire &remove = feature.removes[iRemove];
+            if (remove.profile == "core") {
+                context.compatibilityNames.insert(remove.enums.begin(), remove.enums.end());
+                context.compatibilityNames.insert(remove.commands.begin(), remove.commands.end());
+            }
+        }
+    }
+
+    // The types are the same ones output by glbBuildGenerateCode_C_Main_RequireTypes().
+    for (size_t iBlock = 0; iBlock < context.blocks.size(); ++iBlock) {
+        const std::vector<glbRequire> &requires = *context.blocks[iBlock].pRequires;
+        for (size_t iRequire = 0; iRequire < requires.size(); ++iRequire) {
+            const glbRequire &require = requires[iRequire];
+            for (size_t iType = 0; iType < require.types.size(); ++iType) {
+                glbBuildAddBlockReference(context.typeBlocks, require.types[iType], iBlock);
+            }
+
+            for (size_t iCommand = 0; iCommand < require.commands.size(); ++iCommand) {
+                auto command = context.commandsByName.find(require.commands[iCommand]);
+                if (command != context.commandsByName.end()) {
+                    const glbCommand* pCommand = command->second;
+                    if (pCommand->returnType != "") {
+                        glbBuildAddBlockReference(context.typeBlocks, pCommand->returnType, iBlock);
+                    }
+
+                    for (size_t iParam = 0; iParam < pCommand->params.size(); ++iParam) {
+                        if (pCommand->params[iParam].type != "") {
+                            glbBuildAddBlockReference(context.typeBlocks, pCommand->params[iParam].type, iBlock);
+                        }
+                    }
+                }
+
+                glbBuildAddBlockReference(context.commandBlocks, require.commands[iCommand], iBlock);
+            }
+        }
+    }
+
+    for (auto command = context.commandBlocks.begin(); command != context.commandBlocks.end(); ++command) {
+        context.commandConditions[command->first] = glbBuildGetCommandCondition(context, command->first, command->second);
+    }
+}
+
+glbResult glbBuildIndexRegistry(glbBuild &context)
+{
+    context.typesByName.clear();
+    context.enumsByName.clear();
+    context.commandsByName.clear();
+
+    // emplace() does not replace existing items which means the first definition of a name is the one that's used.
+    for (size_t iType = 0; iType < context.types.size(); ++iType) {
+        context.typesByName.emplace(context.types[iType].name, &context.types[iType]);
+    }
+
+    for (size_t iEnums = 0; iEnums < context.enums.size(); ++iEnums) {
+        glbEnums &enums = context.enums[iEnums];
+        for (size_t iEnum = 0; iEnum < enums.enums.size(); ++iEnum) {
+            context.enumsByName.emplace(enums.enums[iEnum].name, &enums.enums[iEnum]);
+        }
+    }
+
+    for (size_t iCommands = 0; iCommands < context.commands.size(); ++iCommands) {
+        glbCommands &commands = context.commands[iCommands];
+        for (size_t iCommand = 0; iCommand < commands.commands.size(); ++iCommand) {
+            context.commandsByName.emplace(commands.commands[iCommand].name, &commands.commands[iCommand]);
+        }
+    }
+
+    glbBuildIndexBlocks(context);
+
+    return GLB_SUCCESS;
+}
+
+
+glbResult glbBuildFindType(const glbBuild &context, glbString typeName, const glbType** ppType)
+{
+    auto type = context.typesByName.find(typeName);
+    if (type == context.typesByName.end()) {
+        *ppType = NULL;
+        return GLB_ERROR;
+    }
+
+    *ppType = type->second;
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildFindEnum(const glbBuild &context, glbString enumName, const glbEnum** ppEnum)
+{
+    auto theEnum = context.enumsByName.find(enumName);
+    if (theEnum == context.enumsByName.end()) {
+        *ppEnum = NULL;
+        return GLB_ERROR;
+    }
+
+    *ppEnum = theEnum->second;
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildFindCommand(const glbBuild &context, glbString commandName, const glbCommand** ppCommand)
+{
+    auto command = context.commandsByName.find(commandName);
+    if (command == context.commandsByName.end()) {
+        *ppCommand = NULL;
+        return GLB_ERROR;
+    }
+
+    *ppCommand = command->second;
+    return GLB_SUCCESS;
+}
+
+
+// Each tag of the template is generated from the registry without modifying it which means tags can be generated in parallel. Anything
+// that needs to be tracked while generating a tag lives in a local state object like the one below.
+struct glbBuildMainState
+{
+    std::unordered_set<glbString> outputTypes;         // Types and commands are shared between features and extensions, but must only be
+    std::unordered_set<glbString> outputCommands;      // declared once.
+    std::unordered_set<glbString> blockTypes;          // The types and commands already handled in the current block.
+    std::unordered_set<glbString> blockCommands;
+    size_t iBlock;
+    std::string condition;                             // The condition of the current #if block. See glbOutputSetCondition().
+};
+
+// A type or command that's already been declared by an earlier block needs to be declared again if none of those blocks are included.
+// Returns false if it's already guaranteed to be declared.
+bool glbBuildGetRedeclarationCondition(const glbBuild &context, const glbBuildMainState &state, glbString name, const std::vector<size_t> &blocks, std::string &conditionOut)
+{
+    const glbBuildBlock &block = context.blocks[state.iBlock];
+    const char* platform = glbBuildGetSectionPlatform(block.section);
+
+    conditionOut = "";
+    for (size_t i = 0; i < blocks.size() && blocks[i] < state.iBlock; ++i) {
+        const glbBuildBlock &prevBlock = context.blocks[blocks[i]];
+        const char* prevPlatform = glbBuildGetSectionPlatform(prevBlock.section);
+        bool isCompatibility = (prevBlock.section == GLB_BUILD_SECTION_FEATURES && context.compatibilityNames.count(name) > 0);
+
+        if (prevBlock.condition.empty() && !isCompatibility && (prevPlatform == NULL || (platform != NULL && strcmp(platform, prevPlatform) == 0))) {
+            return false;
+        }
+
+        // The name of a block is only defined when it's included, or when it's been defined by another header in which case that header
+        // has declared it instead.
+        if (isCompatibility) {
+            conditionOut = glbAndConditions(conditionOut, "(!defined(" + prevBlock.name + ") || defined(GLBIND_NO_COMPATIBILITY))");
         } else {
-            typeC += pChild->Value();
+            conditionOut = glbAndConditions(conditionOut, "!defined(" + prevBlock.name + ")");
         }
     }
 
-    typeC = glbTrim(typeC);
-
-    return GLB_SUCCESS;
+    return true;
 }
 
-glbResult glbBuildParseCommandParam(glbBuild &context, tinyxml2::XMLElement* pXMLElement, glbCommandParam &param)
+glbResult glbBuildGenerateCode_C_Main_Type(const glbBuild &context, glbBuildMainState &state, glbString typeName, glbOutput &codeOut)
 {
-    (void)context;
+    // Special case for khrplatform. We don't want to include this because we don't use khrplatform.h. Just pretend it's already been output.
+    if (typeName == "khrplatform") {
+        return GLB_ALREADY_PROCESSED;
+    }
 
-    return glbBuildParseTypeNamePair(pXMLElement, param.type, param.typeC, param.name);
+    if (state.blockTypes.count(typeName) > 0) {
+        return GLB_ALREADY_PROCESSED;
+    }
+    state.blockTypes.insert(typeName);
+
+    // We only output the type if it hasn't already been output, or if the blocks that output it might have been excluded.
+    std::string condition;
+    if (state.outputTypes.count(typeName) > 0) {
+        if (!glbBuildGetRedeclarationCondition(context, state, typeName, context.typeBlocks.at(typeName), condition)) {
+            return GLB_ALREADY_PROCESSED;
+        }
+    }
+
+    const glbType* pType;
+    glbResult result = glbBuildFindType(context, typeName, &pType);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    if (pType->valueC != "") {
+        glbOutputSetCondition(codeOut, state.condition, condition);
+        codeOut << pType->valueC << "\n";
+    }
+
+    state.outputTypes.insert(typeName);
+
+    return GLB_SUCCESS;
 }
 
-glbResult glbBuildParseCommand(glbBuild &context, tinyxml2::XMLElement* pXMLElement, glbCommand &command)
+glbResult glbBuildGenerateCode_C_Main_RequireTypes(const glbBuild &context, glbBuildMainState &state, const glbRequire &require, glbOutput &codeOut)
 {
-    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
-        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
-        if (pChildElement == NULL) {
-            continue;
-        }
+    glbResult result;
 
-        if (strcmp(pChildElement->Name(), "proto") == 0) {
-            glbBuildParseTypeNamePair(pChildElement, command.returnType, command.returnTypeC, command.name);
+    // Standalone types.
+    for (size_t iType = 0; iType < require.types.size(); ++iType) {
+        result = glbBuildGenerateCode_C_Main_Type(context, state, require.types[iType], codeOut);
+        if (result != GLB_SUCCESS && result != GLB_ALREADY_PROCESSED) {
+            return result;
         }
+    }
 
-        if (strcmp(pChildElement->Name(), "param") == 0) {
-            glbCommandParam param;
-            glbResult result = glbBuildParseCommandParam(context, pChildElement, param);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+    // Required types.
+    for (size_t iCommand = 0; iCommand < require.commands.size(); ++iCommand) {
+        const glbCommand* pCommand;
+        result = glbBuildFindCommand(context, require.commands[iCommand], &pCommand);
+        if (result != GLB_SUCCESS) {
+            return result;
+        }
 
-            command.params.push_back(param);
+        if (pCommand->returnType != "") {
+            glbBuildGenerateCode_C_Main_Type(context, state, pCommand->returnType, codeOut);
         }
 
-        if (strcmp(pChildElement->Name(), "alias") == 0) {
-            const char* alias = pChildElement->Attribute("name");
-            command.alias = (alias != NULL) ? alias : "";
+        for (size_t iParam = 0; iParam < pCommand->params.size(); ++iParam) {
+            const glbCommandParam &param = pCommand->params[iParam];
+            if (param.type != "") {
+                glbBuildGenerateCode_C_Main_Type(context, state, param.type, codeOut);
+            }
         }
     }
 
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildParseCommands(glbBuild &context, tinyxml2::XMLElement* pXMLElement)
+// Anything in a feature that's been removed from the core profile is excluded with GLBIND_NO_COMPATIBILITY.
+std::string glbBuildGetCompatibilityCondition(const glbBuild &context, const glbBuildMainState &state, glbString name)
 {
-    glbCommands commands;
+    if (context.blocks[state.iBlock].section == GLB_BUILD_SECTION_FEATURES && context.compatibilityNames.count(name) > 0) {
+        return "!defined(GLBIND_NO_COMPATIBILITY)";
+    }
 
-    const char* namespaceAttrib = pXMLElement->Attribute("namespace");
-    commands.namespaceAttrib = (namespaceAttrib != NULL) ? namespaceAttrib : "";
+    return "";
+}
 
-    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
-        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
-        if (pChildElement == NULL) {
-            continue;
-        }
+glbResult glbBuildGenerateCode_C_Main_RequireEnums(const glbBuild &context, glbBuildMainState &state, const glbRequire &require, glbOutput &codeOut)
+{
+    glbResult result;
 
-        if (strcmp(pChildElement->Name(), "command") == 0) {
-            glbCommand command;
-            glbResult result = glbBuildParseCommand(context, pChildElement, command);
-            if (result == GLB_SUCCESS) {
-                commands.commands.push_back(command);
-            }
+    for (size_t iEnum = 0; iEnum < require.enums.size(); ++iEnum) {
+        const glbEnum* pEnum;
+        result = glbBuildFindEnum(context, require.enums[iEnum], &pEnum);
+        if (result != GLB_SUCCESS) {
+            return result;
         }
-    }
 
-    context.commands.push_back(commands);
+        glbOutputSetCondition(codeOut, state.condition, glbBuildGetCompatibilityCondition(context, state, pEnum->name));
+        codeOut << "#define " << pEnum->name << " " << pEnum->value << "\n";
+    }
 
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildParseRequire(glbBuild &context, tinyxml2::XMLElement* pXMLElement, glbRequire &require)
+glbResult glbBuildGenerateCode_C_Main_RequireCommands(const glbBuild &context, glbBuildMainState &state, const glbRequire &require, glbOutput &codeOut)
 {
-    (void)context;
+    glbResult result;
 
-    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
-        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
-        if (pChildElement == NULL) {
+    for (size_t iCommand = 0; iCommand < require.commands.size(); ++iCommand) {
+        glbString commandName = require.commands[iCommand];
+        if (state.blockCommands.count(commandName) > 0) {
             continue;
         }
+        state.blockCommands.insert(commandName);
 
-        if (strcmp(pChildElement->Name(), "type") == 0) {
-            require.types.push_back(pChildElement->Attribute("name"));
+        std::string condition = glbBuildGetCompatibilityCondition(context, state, commandName);
+        if (state.outputCommands.count(commandName) > 0) {
+            std::string redeclarationCondition;
+            if (!glbBuildGetRedeclarationCondition(context, state, commandName, context.commandBlocks.at(commandName), redeclarationCondition)) {
+                continue;
+            }
+
+            condition = glbAndConditions(condition, redeclarationCondition);
         }
 
-        if (strcmp(pChildElement->Name(), "enum") == 0) {
-            require.enums.push_back(pChildElement->Attribute("name"));
+        const glbCommand* pCommand;
+        result = glbBuildFindCommand(context, commandName, &pCommand);
+        if (result != GLB_SUCCESS) {
+            return result;
         }
 
-        if (strcmp(pChildElement->Name(), "command") == 0) {
-            require.commands.push_back(pChildElement->Attribute("name"));
+        glbOutputSetCondition(codeOut, state.condition, condition);
+
+        codeOut << "typedef " << pCommand->returnTypeC << " (APIENTRYP PFN" << glbToUpperCase(pCommand->name) << "PROC)(";
+        if (pCommand->params.size() > 0) {
+            for (size_t iParam = 0; iParam < pCommand->params.size(); ++iParam) {
+                if (iParam != 0) {
+                    codeOut << ", ";
+                }
+                codeOut << pCommand->params[iParam].typeC << " " << pCommand->params[iParam].name;
+            }
+        } else {
+            codeOut << "void";  // we need to use "func(void)" syntax for compatibility with older versions of C.
         }
+        codeOut << ");\n";
+
+        state.outputCommands.insert(commandName);
     }
 
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildParseFeature(glbBuild &context, tinyxml2::XMLElement* pXMLElement)
+
+glbResult glbBuildGenerateCode_C_Main_Block(const glbBuild &context, glbBuildMainState &state, size_t iBlock, glbOutput &codeOut)
 {
-    glbFeature feature;
+    const glbBuildBlock &block = context.blocks[iBlock];
+    const std::vector<glbRequire> &requires = *block.pRequires;
+
+    state.iBlock = iBlock;
+    state.blockTypes.clear();
+    state.blockCommands.clear();
+
+    // GLBIND_HAS_* is defined whether or not the block itself has already been defined by another header since it's what controls
+    // whether or not the function pointers are declared and loaded.
+    if (block.condition.empty()) {
+        codeOut << "#define GLBIND_HAS_" << block.name << "\n";
+        codeOut << "#ifndef " << block.name << "\n";
+    } else {
+        codeOut << "#if " << block.condition << "\n";
+        codeOut << "#define GLBIND_HAS_" << block.name << "\n";
+        codeOut << "#endif\n";
+        codeOut << "#if defined(GLBIND_HAS_" << block.name << ") && !defined(" << block.name << ")\n";
+    }
+    codeOut << "#define " << block.name << " 1\n";
+    {
+        // Types.
+        for (size_t iRequire = 0; iRequire < requires.size(); ++iRequire) {
+            glbResult result = glbBuildGenerateCode_C_Main_RequireTypes(context, state, requires[iRequire], codeOut);
+            if (result != GLB_SUCCESS) {
+                return result;
+            }       
+        }
 
-    const char* api    = pXMLElement->Attribute("api");
-    const char* name   = pXMLElement->Attribute("name");
-    const char* number = pXMLElement->Attribute("number");
+        // Enums.
+        for (size_t iRequire = 0; iRequire < requires.size(); ++iRequire) {
+            glbResult result = glbBuildGenerateCode_C_Main_RequireEnums(context, state, requires[iRequire], codeOut);
+            if (result != GLB_SUCCESS) {
+                return result;
+            }       
+        }
 
-    feature.api    = (api    != NULL) ? api    : "";
-    feature.name   = (name   != NULL) ? name   : "";
-    feature.number = (number != NULL) ? number : "";
+        // Commands.
+        for (size_t iRequire = 0; iRequire < requires.size(); ++iRequire) {
+            glbResult result = glbBuildGenerateCode_C_Main_RequireCommands(context, state, requires[iRequire], codeOut);
+            if (result != GLB_SUCCESS) {
+                return result;
+            }       
+        }
 
-    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
-        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
-        if (pChildElement == NULL) {
-            continue;
+        glbOutputSetCondition(codeOut, state.condition, "");
+    }
+    codeOut << "#endif /* " << block.name << " */\n";
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildGenerateCode_C_Main(const glbBuild &context, glbOutput &codeOut)
+{
+    glbResult result;
+    glbBuildMainState state;
+
+    // Section order is the following. Features first so that extensions can make use of the types they declare.
+    //  - gl features
+    //  - wgl features
+    //  - glx features
+    //  - gl extensions
+    //  - wgl extensions
+    //  - glx extensions
+    for (int iSection = 0; iSection < GLB_BUILD_SECTION_COUNT; ++iSection) {
+        const char* platform = glbBuildGetSectionPlatform(iSection);
+        if (platform != NULL) {
+            codeOut << "\n#if defined(" << platform << ")\n";
         }
 
-        if (strcmp(pChildElement->Name(), "require") == 0) {
-            glbRequire require;
-            glbResult result = glbBuildParseRequire(context, pChildElement, require);
+        // If a platform has been excluded, using the header on that platform would otherwise fail with a flood of errors from the template.
+        if (iSection == GLB_BUILD_SECTION_WGL_FEATURES && !context.selection.wgl) {
+            codeOut << "#error \"This version of glbind.h was generated without WGL support.\"\n";
+        }
+        if (iSection == GLB_BUILD_SECTION_GLX_FEATURES && !context.selection.glx) {
+            codeOut << "#error \"This version of glbind.h was generated without GLX support.\"\n";
+        }
+
+        int counter = 0;    // Used for tracking whether or not new lines need to be added.
+        for (size_t iBlock = 0; iBlock < context.blocks.size(); ++iBlock) {
+            if (context.blocks[iBlock].section != iSection) {
+                continue;
+            }
+
+            if (counter > 0) {
+                codeOut << "\n";
+            }
+            counter += 1;
+
+            result = glbBuildGenerateCode_C_Main_Block(context, state, iBlock, codeOut);
             if (result != GLB_SUCCESS) {
                 return result;
             }
+        }
 
-            feature.requires.push_back(require);
+        if (platform != NULL) {
+            codeOut << "#endif /* " << platform << " */\n";
         }
     }
 
-    context.features.push_back(feature);
-
     return GLB_SUCCESS;
 }
 
 
-glbResult glbBuildParseExtension(glbBuild &context, tinyxml2::XMLElement* pXMLElement, glbExtension &extension)
+// Gathers the names of the commands that have a function pointer, grouped by section. Each command is listed once, in the section of
+// the first block that requires it. With the platform features this is the order of the members of GLBapi.
+glbResult glbBuildGetCommandSections(const glbBuild &context, bool includePlatformFeatures, std::vector<glbString> sectionNames[GLB_BUILD_SECTION_COUNT])
 {
-    const char* name      = pXMLElement->Attribute("name");
-    const char* supported = pXMLElement->Attribute("supported");
-
-    extension.name      = (name      != NULL) ? name      : "";
-    extension.supported = (supported != NULL) ? supported : "";
+    std::unordered_set<glbString> processedCommands;
 
-    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
-        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
-        if (pChildElement == NULL) {
+    for (size_t iBlock = 0; iBlock < context.blocks.size(); ++iBlock) {
+        const glbBuildBlock &block = context.blocks[iBlock];
+        if (!includePlatformFeatures && (block.section == GLB_BUILD_SECTION_WGL_FEATURES || block.section == GLB_BUILD_SECTION_GLX_FEATURES)) {
             continue;
         }
 
-        if (strcmp(pChildElement->Name(), "require") == 0) {
-            glbRequire require;
-            glbResult result = glbBuildParseRequire(context, pChildElement, require);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+        for (size_t iRequire = 0; iRequire < block.pRequires->size(); ++iRequire) {
+            const glbRequire &require = (*block.pRequires)[iRequire];
+            for (size_t iCommand = 0; iCommand < require.commands.size(); ++iCommand) {
+                glbString commandName = require.commands[iCommand];
+                if (!glbBuildIsCommandIgnored(commandName.c_str()) && processedCommands.count(commandName) == 0) {
+                    const glbCommand* pCommand;
+                    glbResult result = glbBuildFindCommand(context, commandName, &pCommand);
+                    if (result != GLB_SUCCESS) {
+                        return result;
+                    }
 
-            extension.requires.push_back(require);
+                    sectionNames[block.section].push_back(pCommand->name);
+                    processedCommands.insert(commandName);
+                }
+            }
         }
     }
 
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildParseExtensions(glbBuild &context, tinyxml2::XMLElement* pXMLElement)
+// Outputs a line for each command. Each section is wrapped in the #if block for its platform, and each command in the #if block for the
+// blocks that require it. There is no new line character at the end.
+template <typename FormatLine>
+void glbBuildGenerateCode_C_CommandLines(const glbBuild &context, const std::vector<glbString> sectionNames[GLB_BUILD_SECTION_COUNT], FormatLine formatLine, glbOutput &codeOut)
 {
-    for (tinyxml2::XMLNode* pChild = pXMLElement->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
-        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
-        if (pChildElement == NULL) {
+    std::string condition;
+
+    for (int iSection = 0; iSection < GLB_BUILD_SECTION_COUNT; ++iSection) {
+        const char* platform = glbBuildGetSectionPlatform(iSection);
+        if (sectionNames[iSection].empty() && (iSection == GLB_BUILD_SECTION_WGL_FEATURES || iSection == GLB_BUILD_SECTION_GLX_FEATURES)) {
             continue;
         }
 
-        if (strcmp(pChildElement->Name(), "extension") == 0) {
-            glbExtension extension;
-            glbResult result = glbBuildParseExtension(context, pChildElement, extension);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
-
-            context.extensions.push_back(extension);
+        if (platform != NULL) {
+            codeOut << "#if defined(" << platform << ")\n";
+        }
+        for (size_t iName = 0; iName < sectionNames[iSection].size(); ++iName) {
+            const glbString &name = sectionNames[iSection][iName];
+            glbOutputSetCondition(codeOut, condition, context.commandConditions.at(name));
+            formatLine(name, codeOut);
+        }
+        glbOutputSetCondition(codeOut, condition, "");
+        if (platform != NULL) {
+            codeOut << "#endif /* " << platform << " */\n";
         }
     }
 
-    return GLB_SUCCESS;
+    glbOutputTrimNewLine(codeOut);
 }
 
-glbResult glbBuildLoadXML(glbBuild &context, tinyxml2::XMLDocument &doc)
+// Outputs a function pointer for each command, each line starting with linePrefix. The WGL and GLX features are not declared at global
+// scope because some platform headers declare their own symbols for them, such as wglCreateContext(). They're still members of GLBapi.
+glbResult glbBuildGenerateCode_C_FuncPointers(const glbBuild &context, bool isGlobalScope, const char* linePrefix, glbOutput &codeOut)
 {
-    // The root node is the <registry> node.
-    tinyxml2::XMLElement* pRoot = doc.RootElement();
-    if (pRoot == NULL) {
-        printf("Failed to retrieve root node.\n");
-        return -1;
+    std::vector<glbString> sectionNames[GLB_BUILD_SECTION_COUNT];
+    glbResult result = glbBuildGetCommandSections(context, !isGlobalScope, sectionNames);
+    if (result != GLB_SUCCESS) {
+        return result;
     }
 
-    if (strcmp(pRoot->Name(), "registry") != 0) {
-        printf("Unexpected root node. Expecting \"registry\", but got \"%s\"", pRoot->Name());
-        return -1;
+    glbBuildGenerateCode_C_CommandLines(context, sectionNames, [&](const glbString &name, glbOutput &lineOut) {
+        lineOut << linePrefix << "PFN" << glbToUpperCase(name) << "PROC " << name << ";\n";
+    }, codeOut);
+
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildGenerateCode_C_SetGlobalAPIFromStruct(const glbBuild &context, glbOutput &codeOut)
+{
+    std::vector<glbString> sectionNames[GLB_BUILD_SECTION_COUNT];
+    glbResult result = glbBuildGetCommandSections(context, false, sectionNames);
+    if (result != GLB_SUCCESS) {
+        return result;
     }
 
-    for (tinyxml2::XMLNode* pChild = pRoot->FirstChild(); pChild != NULL; pChild = pChild->NextSibling()) {
-        tinyxml2::XMLElement* pChildElement = pChild->ToElement();
-        if (pChildElement == NULL) {
-            continue;   // Could be a comment. In any case we don't care about anything that's not in a child node.
-        }
+    glbBuildGenerateCode_C_CommandLines(context, sectionNames, [&](const glbString &name, glbOutput &lineOut) {
+        lineOut << "    " << name << " = pAPI->" << name << ";\n";
+    }, codeOut);
 
-        if (strcmp(pChildElement->Name(), "types") == 0) {
-            glbBuildParseTypes(context, pChildElement);
-        }
-        if (strcmp(pChildElement->Name(), "groups") == 0) {
-            glbBuildParseGroups(context, pChildElement);
-        }
-        if (strcmp(pChildElement->Name(), "enums") == 0) {
-            glbBuildParseEnums(context, pChildElement);
+    return GLB_SUCCESS;
+}
+
+// Packs the names of every command into a single block of memory. The names are in the same order as the members of GLBapi.
+// The pool is split into chunks to keep each string literal within the length that compilers are required to support. Each chunk takes
+// up GLB_BUILD_MAX_STRING_LITERAL_LENGTH + 1 bytes, including the null terminator and any padding after the last name.
+void glbBuildGetCommandNamePool(const std::vector<glbString> sectionNames[GLB_BUILD_SECTION_COUNT], std::vector<std::string> &chunks, std::unordered_map<glbString, size_t> &offsets)
+{
+    size_t chunkBaseOffset = 0;
+    chunks.push_back("");
+
+    for (int iSection = 0; iSection < GLB_BUILD_SECTION_COUNT; ++iSection) {
+        for (size_t iName = 0; iName < sectionNames[iSection].size(); ++iName) {
+            glbString name = sectionNames[iSection][iName];
+            if (chunks.back().size() + name.size() + 1 > GLB_BUILD_MAX_STRING_LITERAL_LENGTH) {
+                chunkBaseOffset += GLB_BUILD_MAX_STRING_LITERAL_LENGTH + 1;
+                chunks.push_back("");
+            }
+
+            offsets[name] = chunkBaseOffset + chunks.back().size();
+            chunks.back() += name.str() + '\0';
         }
-        if (strcmp(pChildElement->Name(), "commands") == 0) {
-            glbBuildParseCommands(context, pChildElement);
+    }
+}
+
+glbResult glbBuildGenerateCode_C_CommandNames(const glbBuild &context, glbOutput &codeOut)
+{
+    std::vector<glbString> sectionNames[GLB_BUILD_SECTION_COUNT];
+    glbResult result = glbBuildGetCommandSections(context, true, sectionNames);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    // The pool itself is not platform specific, nor does it depend on which blocks are included. Including every name costs some
+    // read-only data, but it means the offsets are known when the file is generated. The chunks are the rows of a single array so
+    // they're still laid out contiguously in memory.
+    std::vector<std::string> chunks;
+    std::unordered_map<glbString, size_t> offsets;
+    glbBuildGetCommandNamePool(sectionNames, chunks, offsets);
+
+    codeOut << "static const char glbind_CommandNamePool[" << chunks.size() << "][" << (size_t)GLB_BUILD_MAX_STRING_LITERAL_LENGTH + 1 << "] = {\n";
+    for (size_t iChunk = 0; iChunk < chunks.size(); ++iChunk) {
+        if (iChunk > 0) {
+            codeOut << ",\n";
         }
-        if (strcmp(pChildElement->Name(), "feature") == 0) {
-            glbBuildParseFeature(context, pChildElement);
+
+        const std::string &chunk = chunks[iChunk];
+        for (size_t iName = 0; iName < chunk.size(); iName = chunk.find('\0', iName) + 1) {
+            if (iName > 0) {
+                codeOut << "\n";
+            }
+            codeOut << "    \"" << (chunk.c_str() + iName) << "\\0\"";
         }
-        if (strcmp(pChildElement->Name(), "extensions") == 0) {
-            glbBuildParseExtensions(context, pChildElement);
+    }
+    codeOut << "\n};\n\n";
+
+    // Only the offsets of included commands are output, which keeps them in sync with GLBapi.
+    codeOut << "static const khronos_uint32_t glbind_CommandNameOffsets[] = {\n";
+    glbBuildGenerateCode_C_CommandLines(context, sectionNames, [&](const glbString &name, glbOutput &lineOut) {
+        lineOut << "    " << offsets[name] << ",\n";
+    }, codeOut);
+    codeOut << "\n};";
+
+    return GLB_SUCCESS;
+}
+
+
+// A run of consecutive commands with the same condition. The perfect hash refers to commands by their run rather than by their member
+// of GLBapi since the members depend on which runs have been compiled in.
+struct glbCommandRun
+{
+    std::string condition;
+    std::vector<glbString> names;
+};
+
+// Splits the commands into runs. The runs are in the same order as the members of GLBapi and their conditions include the platform of
+// the section. offsets is set to the offset of each name in glbind_CommandNamePool.
+glbResult glbBuildGetCommandRuns(const glbBuild &context, std::vector<glbCommandRun> &runs, std::unordered_map<glbString, size_t> &offsets)
+{
+    std::vector<glbString> sectionNames[GLB_BUILD_SECTION_COUNT];
+    glbResult result = glbBuildGetCommandSections(context, true, sectionNames);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    std::vector<std::string> chunks;
+    glbBuildGetCommandNamePool(sectionNames, chunks, offsets);
+
+    for (int iSection = 0; iSection < GLB_BUILD_SECTION_COUNT; ++iSection) {
+        const char* platform = glbBuildGetSectionPlatform(iSection);
+        for (size_t iName = 0; iName < sectionNames[iSection].size(); ++iName) {
+            glbString name = sectionNames[iSection][iName];
+
+            std::string condition = context.commandConditions.at(name);
+            if (platform != NULL) {
+                condition = glbAndConditions(std::string("defined(") + platform + ")", glbContains(condition, "||") ? "(" + condition + ")" : condition);
+            }
+
+            if (runs.empty() || runs.back().condition != condition) {
+                glbCommandRun run;
+                run.condition = condition;
+                runs.push_back(run);
+            }
+
+            runs.back().names.push_back(name);
         }
     }
 
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildLoadXMLFile(glbBuild &context, const char* filePath)
+// Must match glbind_HashCommandName() in the template.
+uint32_t glbHashCommandName(const char* name, uint32_t seed)
 {
-    tinyxml2::XMLDocument docGL;
-    tinyxml2::XMLError xmlError = docGL.LoadFile(filePath);
-    if (xmlError != tinyxml2::XML_SUCCESS) {
-        printf("Failed to parse %s\n", filePath);
-        return (int)xmlError;
+    uint32_t hash = 2166136261U ^ seed;
+    while (*name) {
+        hash = (hash ^ (unsigned char)*name) * 16777619U;
+        name += 1;
     }
 
-    return glbBuildLoadXML(context, docGL);
-}
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6BU;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35U;
+    hash ^= hash >> 16;
 
+    return hash;
+}
 
-bool glbDoesExtensionBelongToVendor(const std::string &extensionName, const std::string &vendor)
+struct glbCommandHashEntry
 {
-    return extensionName.find("_" + vendor + "_") != std::string::npos;
-}
+    size_t nameOffset;
+    size_t run;
+    size_t index;
+};
 
-bool glbIsExtensionBlackListed(const char* extensionName)
+// Outputs the minimal perfect hash used by glbGetProcFromAPI(). Names are split into buckets of about 4 names with the first hash. The
+// largest buckets are placed first by searching for a seed of the second hash that puts every name of the bucket in a free entry. Buckets
+// with a single name are placed last and refer to their entry directly which is what allows every entry to be used.
+glbResult glbBuildGenerateCode_C_CommandHash(const glbBuild &context, glbOutput &codeOut)
 {
-    for (auto blacklistedExtension : g_BlacklistedExtensions) {
-        if (strcmp(blacklistedExtension, extensionName) == 0) {
-            return true;
+    std::vector<glbCommandRun> runs;
+    std::unordered_map<glbString, size_t> offsets;
+    glbResult result = glbBuildGetCommandRuns(context, runs, offsets);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    std::vector<glbString> names;
+    std::vector<glbCommandHashEntry> keys;
+    for (size_t iRun = 0; iRun < runs.size(); ++iRun) {
+        for (size_t iName = 0; iName < runs[iRun].names.size(); ++iName) {
+            glbCommandHashEntry key;
+            key.nameOffset = offsets[runs[iRun].names[iName]];
+            key.run        = iRun;
+            key.index      = iName;
+            keys.push_back(key);
+            names.push_back(runs[iRun].names[iName]);
         }
     }
 
-    for (auto vendor : g_BlacklistedExtensionVendors) {
-        if (glbDoesExtensionBelongToVendor(extensionName, vendor)) {
-            return true;
+    // The tables can't be empty so there is always at least one entry. Without any commands the entry refers to an empty run.
+    size_t entryCount  = std::max<size_t>(keys.size(), 1);
+    size_t bucketCount = std::max<size_t>((keys.size() + 3) / 4, 1);
+
+    std::vector<std::vector<size_t>> buckets(bucketCount);
+    for (size_t iKey = 0; iKey < keys.size(); ++iKey) {
+        buckets[glbHashCommandName(names[iKey].c_str(), 0) % bucketCount].push_back(iKey);
+    }
+
+    std::vector<size_t> bucketOrder(bucketCount);
+    for (size_t iBucket = 0; iBucket < bucketCount; ++iBucket) {
+        bucketOrder[iBucket] = iBucket;
+    }
+    std::stable_sort(bucketOrder.begin(), bucketOrder.end(), [&](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+    std::vector<int64_t> bucketValues(bucketCount, 0);
+    std::vector<glbCommandHashEntry> entries(entryCount);
+    std::vector<bool> isEntryUsed(entryCount, false);
+    std::vector<size_t> bucketEntries;
+    size_t nextFreeEntry = 0;
+
+    for (size_t iOrder = 0; iOrder < bucketCount; ++iOrder) {
+        const std::vector<size_t> &bucket = buckets[bucketOrder[iOrder]];
+        if (bucket.empty()) {
+            break;
+        }
+
+        if (bucket.size() == 1) {
+            while (isEntryUsed[nextFreeEntry]) {
+                nextFreeEntry += 1;
+            }
+
+            bucketEntries.assign(1, nextFreeEntry);
+            bucketValues[bucketOrder[iOrder]] = -(int64_t)nextFreeEntry - 1;
+        } else {
+            uint32_t seed;
+            for (seed = 1; seed < INT32_MAX; ++seed) {
+                bucketEntries.clear();
+                for (size_t iKey = 0; iKey < bucket.size(); ++iKey) {
+                    size_t iEntry = glbHashCommandName(names[bucket[iKey]].c_str(), seed) % entryCount;
+                    if (isEntryUsed[iEntry] || std::find(bucketEntries.begin(), bucketEntries.end(), iEntry) != bucketEntries.end()) {
+                        break;
+                    }
+                    bucketEntries.push_back(iEntry);
+                }
+
+                if (bucketEntries.size() == bucket.size()) {
+                    break;
+                }
+            }
+
+            if (seed == INT32_MAX) {
+                printf("Failed to generate the command hash.\n");
+                return GLB_ERROR;
+            }
+
+            bucketValues[bucketOrder[iOrder]] = seed;
+        }
+
+        for (size_t iKey = 0; iKey < bucket.size(); ++iKey) {
+            entries[bucketEntries[iKey]] = keys[bucket[iKey]];
+            isEntryUsed[bucketEntries[iKey]] = true;
         }
     }
 
-    return false;
-}
+    codeOut << "#define GLBIND_COMMAND_HASH_BUCKET_COUNT    " << bucketCount << "\n";
+    codeOut << "#define GLBIND_COMMAND_HASH_ENTRY_COUNT     " << entryCount << "\n";
+    codeOut << "\n";
 
-bool glbBuildIsCommandIgnored(const char* commandName)
-{
-    // The following commands should not be included in anything as they are not strictly OpenGL related.
-    static const char* ignoredCommands[] = {
-        "ChoosePixelFormat",
-        "DescribePixelFormat",
-        "GetEnhMetaFilePixelFormat",
-        "GetPixelFormat",
-        "SetPixelFormat",
-        "SwapBuffers",
-        "wglUseFontBitmaps",
-        "wglUseFontOutlines",
-    };
+    codeOut << "static const khronos_int32_t glbind_CommandHashBuckets[GLBIND_COMMAND_HASH_BUCKET_COUNT] = {";
+    for (size_t iBucket = 0; iBucket < bucketCount; ++iBucket) {
+        codeOut << ((iBucket % 16 == 0) ? "\n    " : " ") << std::to_string(bucketValues[iBucket]) << ",";
+    }
+    codeOut << "\n};\n\n";
 
-    for (size_t i = 0; i < sizeof(ignoredCommands)/sizeof(ignoredCommands[0]); ++i) {
-        if (strcmp(ignoredCommands[i], commandName) == 0) {
-            return true;
+    codeOut << "static const glbind_CommandHashEntry glbind_CommandHashEntries[GLBIND_COMMAND_HASH_ENTRY_COUNT] = {";
+    for (size_t iEntry = 0; iEntry < entryCount; ++iEntry) {
+        const glbCommandHashEntry &entry = entries[iEntry];
+        codeOut << ((iEntry % 6 == 0) ? "\n    " : " ") << "{" << entry.nameOffset << ", " << entry.run << ", " << entry.index << "},";
+    }
+    codeOut << "\n};\n\n";
+
+    // The index of the first member of each run. The last one is the total, which gives the size of the last run.
+    codeOut << "enum\n{\n";
+    if (runs.empty()) {
+        codeOut << "    glbind_CommandRunSlot0 = 0,\n";
+        codeOut << "    glbind_CommandRunSlot1 = 0\n";
+    } else {
+        codeOut << "    glbind_CommandRunSlot0 = 0,\n";
+    }
+    for (size_t iRun = 0; iRun < runs.size(); ++iRun) {
+        const glbCommandRun &run = runs[iRun];
+        const char* separator = (iRun + 1 < runs.size()) ? "," : "";
+        if (run.condition.empty()) {
+            codeOut << "    glbind_CommandRunSlot" << iRun + 1 << " = glbind_CommandRunSlot" << iRun << " + " << run.names.size() << separator << "\n";
+        } else {
+            codeOut << "#if " << run.condition << "\n";
+            codeOut << "    glbind_CommandRunSlot" << iRun + 1 << " = glbind_CommandRunSlot" << iRun << " + " << run.names.size() << separator << "\n";
+            codeOut << "#else\n";
+            codeOut << "    glbind_CommandRunSlot" << iRun + 1 << " = glbind_CommandRunSlot" << iRun << separator << "\n";
+            codeOut << "#endif\n";
         }
     }
+    codeOut << "};\n\n";
 
-    return false;
+    codeOut << "static const khronos_uint32_t glbind_CommandRunSlots[] = {";
+    for (size_t iRun = 0; iRun <= std::max<size_t>(runs.size(), 1); ++iRun) {
+        codeOut << ((iRun % 8 == 0) ? "\n    " : " ") << "glbind_CommandRunSlot" << iRun << ",";
+    }
+    codeOut << "\n};";
+
+    return GLB_SUCCESS;
 }
 
+// A member of GLBlimits.
+struct glbLimit
+{
+    std::string enumName;
+    std::string memberName;
+    std::string condition;
+    int type;
+    int count;
+    int version;            // The version of the feature that added the limit, times 10.
+    bool isCompatibility;   // Removed from the core profile.
+};
 
-bool glbBuildHasTypeBeenOutput(glbBuild &context, const char* typeName)
+bool glbIsLimitName(const std::string &name)
 {
-    for (size_t iType = 0; iType < context.outputTypes.size(); ++iType) {
-        if (context.outputTypes[iType] == typeName) {
-            return true;
-        }
+    if (name.compare(0, 7, "GL_MAX_") == 0) {
+        return true;
+    }
+
+    // The pack and unpack alignments are state rather than limits.
+    const char* suffix = "_ALIGNMENT";
+    if (name.size() > 10 && name.compare(name.size() - 10, 10, suffix) == 0) {
+        return name.compare(0, 8, "GL_PACK_") != 0 && name.compare(0, 10, "GL_UNPACK_") != 0;
     }
 
-    return false;   /* Not found. */
+    return false;
 }
 
-bool glbBuildHasCommandBeenOutput(glbBuild &context, const char* commandName)
+bool glbIsInGroup(const std::string &groups, const char* group)
 {
-    for (size_t iCommand = 0; iCommand < context.outputCommands.size(); ++iCommand) {
-        if (context.outputCommands[iCommand] == commandName) {
+    size_t groupLength = strlen(group);
+    for (size_t iGroup = 0; iGroup < groups.size(); ) {
+        size_t iEnd = groups.find(',', iGroup);
+        if (iEnd == std::string::npos) {
+            iEnd = groups.size();
+        }
+
+        if (iEnd - iGroup == groupLength && groups.compare(iGroup, groupLength, group) == 0) {
             return true;
         }
+
+        iGroup = iEnd + 1;
     }
 
-    return false;   /* Not found. */
+    return false;
 }
 
-glbResult glbBuildFindType(glbBuild &context, const char* typeName, glbType** ppType)
+// GL_MAX_TEXTURE_SIZE becomes maxTextureSize.
+std::string glbLimitMemberName(const std::string &enumName)
 {
-    *ppType = NULL;
-
-    for (size_t iType = 0; iType < context.types.size(); ++iType) {
-        if (context.types[iType].name == typeName) {
-            *ppType = &context.types[iType];
-            return GLB_SUCCESS;
+    std::string name;
+    bool isNewWord = false;
+    for (size_t i = 3; i < enumName.size(); ++i) {
+        char c = enumName[i];
+        if (c == '_') {
+            isNewWord = true;
+        } else {
+            name += (isNewWord && !name.empty()) ? (char)toupper(c) : (char)tolower(c);
+            isNewWord = false;
         }
     }
-    
-    return GLB_ERROR;
+
+    return name;
 }
 
-glbResult glbBuildFindEnum(glbBuild &context, const char* enumName, glbEnum** ppEnum)
+// Collects the limits from the features of the main API. Limits are the GL_MAX_* and GL_*_ALIGNMENT enums that can be passed to
+// glGetIntegerv(). That's the GetPName group when the registry has group information. Each limit is tied to the first feature that requires
+// it, which decides both the condition for compiling it in and the version the context needs before it's queried.
+void glbBuildGetLimits(const glbBuild &context, std::vector<glbLimit> &limits)
 {
-    *ppEnum = NULL;
+    std::unordered_set<glbString> getPNames;
+    for (size_t iGroup = 0; iGroup < context.groups.size(); ++iGroup) {
+        if (context.groups[iGroup].name == "GetPName") {
+            for (size_t iEnum = 0; iEnum < context.groups[iGroup].enums.size(); ++iEnum) {
+                getPNames.insert(context.groups[iGroup].enums[iEnum].name);
+            }
+        }
+    }
 
     for (size_t iEnums = 0; iEnums < context.enums.size(); ++iEnums) {
-        glbEnums &enums = context.enums[iEnums];
+        const glbEnums &enums = context.enums[iEnums];
         for (size_t iEnum = 0; iEnum < enums.enums.size(); ++iEnum) {
-            if (context.enums[iEnums].enums[iEnum].name == enumName) {
-                *ppEnum = &context.enums[iEnums].enums[iEnum];
-                return GLB_SUCCESS;
+            if (glbIsInGroup(enums.enums[iEnum].group, "GetPName")) {
+                getPNames.insert(enums.enums[iEnum].name);
             }
         }
     }
-    
-    return GLB_ERROR;
-}
 
-glbResult glbBuildFindCommand(glbBuild &context, const char* commandName, glbCommand** ppCommand)
-{
-    *ppCommand = NULL;
+    std::unordered_set<glbString> processedEnums;
+    for (size_t iFeature = 0; iFeature < context.features.size(); ++iFeature) {
+        const glbFeature &feature = context.features[iFeature];
+        for (size_t iRequire = 0; iRequire < feature.requires.size(); ++iRequire) {
+            const glbRequire &require = feature.requires[iRequire];
+            for (size_t iEnum = 0; iEnum < require.enums.size(); ++iEnum) {
+                glbString enumName = require.enums[iEnum];
+                if (!glbIsLimitName(enumName) || !processedEnums.insert(enumName).second) {
+                    continue;
+                }
 
-    for (size_t iCommands = 0; iCommands < context.commands.size(); ++iCommands) {
-        glbCommands &commands = context.commands[iCommands];
-        for (size_t iCommand = 0; iCommand < commands.commands.size(); ++iCommand) {
-            if (context.commands[iCommands].commands[iCommand].name == commandName) {
-                *ppCommand = &context.commands[iCommands].commands[iCommand];
-                return GLB_SUCCESS;
+                if (getPNames.empty()) {
+                    bool isExcluded = false;
+                    for (const char* exclusion : g_LimitExclusions) {
+                        isExcluded = isExcluded || enumName == exclusion;
+                    }
+
+                    if (isExcluded) {
+                        continue;
+                    }
+                } else if (getPNames.count(enumName) == 0) {
+                    continue;
+                }
+
+                glbLimit limit;
+                limit.enumName        = enumName;
+                limit.memberName      = glbLimitMemberName(enumName);
+                limit.condition       = "defined(GLBIND_HAS_" + feature.name + ")";
+                limit.type            = GLB_LIMIT_INT;
+                limit.count           = 1;
+                limit.version         = glbParseVersionNumber(feature.number) / 10;
+                limit.isCompatibility = context.compatibilityNames.count(enumName) > 0;
+
+                for (const glbLimitInfo &info : g_LimitInfos) {
+                    if (enumName == info.name) {
+                        limit.type  = info.type;
+                        limit.count = info.count;
+                    }
+                }
+
+                if (limit.isCompatibility) {
+                    limit.condition = glbAndConditions(limit.condition, "!defined(GLBIND_NO_COMPATIBILITY)");
+                }
+
+                limits.push_back(limit);
             }
         }
     }
-    
-    return GLB_ERROR;
 }
 
-
-glbResult glbBuildGenerateCode_C_Main_Type(glbBuild &context, const char* typeName, std::string &codeOut)
+// Outputs the members of GLBlimits.
+glbResult glbBuildGenerateCode_C_Limits(const glbBuild &context, glbOutput &codeOut)
 {
-    // Special case for khrplatform. We don't want to include this because we don't use khrplatform.h. Just pretend it's already been output.
-    if (strcmp(typeName, "khrplatform") == 0) {
-        return GLB_ALREADY_PROCESSED;
-    }
+    static const char* memberTypes[] = {"GLint", "khronos_int64_t", "GLfloat", "GLint"};
 
-    // We only output the type if it hasn't already been output.
-    if (!glbBuildHasTypeBeenOutput(context, typeName)) {
-        glbType* pType;
-        glbResult result = glbBuildFindType(context, typeName, &pType);
-        if (result != GLB_SUCCESS) {
-            return result;
+    std::vector<glbLimit> limits;
+    glbBuildGetLimits(context, limits);
+
+    std::string condition;
+    for (size_t iLimit = 0; iLimit < limits.size(); ++iLimit) {
+        const glbLimit &limit = limits[iLimit];
+        glbOutputSetCondition(codeOut, condition, limit.condition);
+
+        codeOut << "    " << memberTypes[limit.type] << " " << limit.memberName;
+        if (limit.count > 1) {
+            codeOut << "[" << (size_t)limit.count << "]";
         }
+        codeOut << ";\n";
+    }
+    glbOutputSetCondition(codeOut, condition, "");
+    glbOutputTrimNewLine(codeOut);
+
+    return GLB_SUCCESS;
+}
 
-        if (pType->valueC != "") {
-            codeOut += pType->valueC + "\n";
+// Outputs glbind_LimitQueries, the table glbQueryLimits() fills GLBlimits from.
+glbResult glbBuildGenerateCode_C_LimitQueries(const glbBuild &context, glbOutput &codeOut)
+{
+    static const char* queryTypes[] = {"GLBIND_LIMIT_INT", "GLBIND_LIMIT_INT64", "GLBIND_LIMIT_FLOAT", "GLBIND_LIMIT_INDEXED_INT"};
+
+    std::vector<glbLimit> limits;
+    glbBuildGetLimits(context, limits);
+
+    // The profile only needs to be checked if there's something that can't be queried with the core profile.
+    std::string condition;
+    for (size_t iLimit = 0; iLimit < limits.size(); ++iLimit) {
+        if (limits[iLimit].isCompatibility) {
+            codeOut << "#if !defined(GLBIND_NO_COMPATIBILITY)\n";
+            codeOut << "#define GLBIND_LIMITS_HAVE_COMPATIBILITY\n";
+            codeOut << "#endif\n\n";
+            break;
         }
+    }
+
+    codeOut << "static const glbind_LimitQuery glbind_LimitQueries[] = {\n";
+    for (size_t iLimit = 0; iLimit < limits.size(); ++iLimit) {
+        const glbLimit &limit = limits[iLimit];
+        glbOutputSetCondition(codeOut, condition, limit.condition);
 
-        context.outputTypes.push_back(typeName);
+        codeOut << "    {" << limit.enumName << ", offsetof(GLBlimits, " << limit.memberName << "), " << queryTypes[limit.type] << ", "
+                << (size_t)limit.count << ", " << (size_t)limit.version << ", " << (limit.isCompatibility ? "GLBIND_LIMIT_FLAG_COMPATIBILITY" : "0") << "},\n";
     }
+    glbOutputSetCondition(codeOut, condition, "");
+    codeOut << "    {0, 0, 0, 0, 0, 0}\n";
+    codeOut << "};";
 
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildGenerateCode_C_Main_RequireTypes(glbBuild &context, glbRequire &require, std::string &codeOut)
+glbResult glbBuildGenerateCode_C_Date(const glbBuild &context, glbOutput &codeOut)
 {
-    glbResult result;
+    (void)context;
 
-    // Standalone types.
-    for (size_t iType = 0; iType < require.types.size(); ++iType) {
-        result = glbBuildGenerateCode_C_Main_Type(context, require.types[iType].c_str(), codeOut);
-        if (result != GLB_SUCCESS && result != GLB_ALREADY_PROCESSED) {
-            return result;
+    time_t t = time(NULL);
+
+    char dateStr[32];
+#if defined(_MSC_VER)
+    struct tm local;
+    localtime_s(&local, &t);
+    strftime(dateStr, sizeof(dateStr), "%Y-%m-%d", &local);
+#else
+    struct tm local;
+    localtime_r(&t, &local);   // Tags are generated on multiple threads.
+    strftime(dateStr, sizeof(dateStr), "%Y-%m-%d", &local);
+#endif
+
+    codeOut << dateStr;
+    return GLB_SUCCESS;
+}
+
+glbResult glbBuildGetOpenGLVersion(const glbBuild &context, std::string &versionOut)
+{
+    // The version can be retrieved from the last feature section of the main API.
+    std::string versionStr;
+    for (auto feature : context.features) {
+        if (feature.api == context.selection.api) {
+            versionStr = feature.number;
         }
     }
 
-    // Required types.
-    for (size_t iCommand = 0; iCommand < require.commands.size(); ++iCommand) {
-        glbCommand* pCommand;
-        result = glbBuildFindCommand(context, require.commands[iCommand].c_str(), &pCommand);
-        if (result != GLB_SUCCESS) {
-            return result;
-        }
+    versionOut = versionStr;
 
-        if (pCommand->returnType != "") {
-            glbBuildGenerateCode_C_Main_Type(context, pCommand->returnType.c_str(), codeOut);
-        }
+    return GLB_SUCCESS;
+}
 
-        for (size_t iParam = 0; iParam < pCommand->params.size(); ++iParam) {
-            glbCommandParam &param = pCommand->params[iParam];
-            if (param.type != "") {
-                glbBuildGenerateCode_C_Main_Type(context, param.type.c_str(), codeOut);
-            }
-        }
+glbResult vkbBuildGenerateCode_C_OpenGLVersion(const glbBuild &context, glbOutput &codeOut)
+{
+    std::string version;
+    glbResult result = glbBuildGetOpenGLVersion(context, version);
+    if (result != GLB_SUCCESS) {
+        return result;
     }
 
+    codeOut << version;
+
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildGenerateCode_C_Main_RequireEnums(glbBuild &context, glbRequire &require, std::string &codeOut)
+// The time taken by each phase of the build, output with --stats. Nested phases, such as each tag of the template, have a depth of 1.
+struct glbBuildStats
 {
-    glbResult result;
+    struct Phase
+    {
+        std::string name;
+        double ms;
+        int depth;
+    };
 
-    for (size_t iEnum = 0; iEnum < require.enums.size(); ++iEnum) {
-        glbEnum* pEnum;
-        result = glbBuildFindEnum(context, require.enums[iEnum].c_str(), &pEnum);
-        if (result != GLB_SUCCESS) {
-            return result;
-        }
+    std::vector<Phase> phases;
+    std::chrono::steady_clock::time_point start      = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point phaseStart = start;
+};
+
+double glbElapsedMS(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
 
-        codeOut += "#define " + pEnum->name + " " + pEnum->value + "\n";
+// Records the time since the end of the previous phase. Does nothing if stats are not being collected.
+void glbBuildStatsEndPhase(glbBuildStats* pStats, const char* name)
+{
+    if (pStats == NULL) {
+        return;
     }
 
-    return GLB_SUCCESS;
+    glbBuildStats::Phase phase = {name, glbElapsedMS(pStats->phaseStart), 0};
+    pStats->phases.push_back(phase);
+    pStats->phaseStart = std::chrono::steady_clock::now();
 }
 
-glbResult glbBuildGenerateCode_C_Main_RequireCommands(glbBuild &context, glbRequire &require, std::string &codeOut)
+// Records a phase that was timed separately, such as the generation of a tag on another thread.
+void glbBuildStatsAddPhase(glbBuildStats* pStats, const char* name, double ms, int depth)
 {
-    glbResult result;
+    if (pStats == NULL) {
+        return;
+    }
 
-    for (size_t iCommand = 0; iCommand < require.commands.size(); ++iCommand) {
-        const char* commandName = require.commands[iCommand].c_str();
-        if (!glbBuildHasCommandBeenOutput(context, commandName)) {
-            glbCommand* pCommand;
-            result = glbBuildFindCommand(context, require.commands[iCommand].c_str(), &pCommand);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+    glbBuildStats::Phase phase = {name, ms, depth};
+    pStats->phases.push_back(phase);
+}
 
-            codeOut += "typedef " + pCommand->returnTypeC + " (APIENTRYP PFN" + glbToUpper(pCommand->name) + "PROC)(";
-            if (pCommand->params.size() > 0) {
-                for (size_t iParam = 0; iParam < pCommand->params.size(); ++iParam) {
-                    if (iParam != 0) {
-                        codeOut += ", ";
-                    }
-                    codeOut += pCommand->params[iParam].typeC + " " + pCommand->params[iParam].name;
-                }
-            } else {
-                codeOut += "void";  // we need to use "func(void)" syntax for compatibility with older versions of C.
-            }
-            codeOut += ");\n";
+void glbBuildPrintStatsPhases(const glbBuildStats &stats);
 
-            context.outputCommands.push_back(commandName);
-        }
+void glbBuildPrintStats(const glbBuild &context, const glbBuildStats &stats)
+{
+    size_t enumCount = 0;
+    for (size_t iEnums = 0; iEnums < context.enums.size(); ++iEnums) {
+        enumCount += context.enums[iEnums].enums.size();
     }
 
-    return GLB_SUCCESS;
+    size_t commandCount = 0;
+    for (size_t iCommands = 0; iCommands < context.commands.size(); ++iCommands) {
+        commandCount += context.commands[iCommands].commands.size();
+    }
+
+    printf("Registry: %zu types, %zu enums, %zu commands, %zu features, %zu extensions (after selection)\n",
+        context.types.size(), enumCount, commandCount, context.features.size(), context.extensions.size());
+
+    glbBuildPrintStatsPhases(stats);
 }
 
+void glbBuildPrintStatsPhases(const glbBuildStats &stats)
+{
+    printf("Stats:\n");
+    for (size_t iPhase = 0; iPhase < stats.phases.size(); ++iPhase) {
+        const glbBuildStats::Phase &phase = stats.phases[iPhase];
+        printf("  %*s%-*s %10.2f ms\n", phase.depth*2, "", 40 - phase.depth*2, phase.name.c_str(), phase.ms);
+    }
+    printf("  %-40s %10.2f ms\n", "total", glbElapsedMS(stats.start));
+}
 
-glbResult glbBuildGenerateCode_C_Main_Feature(glbBuild &context, glbFeature &feature, std::string &codeOut)
+// Options controlling how the output file is generated.
+struct glbBuildGenerateOptions
 {
-    codeOut += "#ifndef " + feature.name + "\n";
-    codeOut += "#define " + feature.name + " 1\n";
-    {
-        // Types.
-        for (size_t iRequire = 0; iRequire < feature.requires.size(); ++iRequire) {
-            glbResult result = glbBuildGenerateCode_C_Main_RequireTypes(context, feature.requires[iRequire], codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }       
-        }
+    std::string templateFilePath = GLB_BUILD_TEMPLATE_PATH;
+    std::string outputFilePath   = GLB_BUILD_OUTPUT_PATH;
+    std::string sourceFilePath;     // When set, the implementation is output to this file rather than the header. See glbBuildSplitTemplate().
+    bool deterministic = false;     // When set, the revision and date are derived from the inputs so the output only depends on them.
+    std::string revision;           // The revision to use in deterministic mode. See glbBuildGetDeterministicRevision().
+    std::string date;               // The date to use in deterministic mode. See glbBuildGetDeterministicDate().
+    glbBuildStats* pStats = NULL;   // When set, the time taken by each phase is recorded.
+};
 
-        // Enums.
-        for (size_t iRequire = 0; iRequire < feature.requires.size(); ++iRequire) {
-            glbResult result = glbBuildGenerateCode_C_Main_RequireEnums(context, feature.requires[iRequire], codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }       
-        }
+// Retrieves the version and date of a previously generated file from the "glbind - vMAJOR.MINOR.REVISION - DATE" line in the header.
+glbResult glbBuildParsePreviousVersion(const char* filePath, std::string &openGLVersionOut, std::string &revisionOut, std::string &dateOut)
+{
+    size_t fileSize;
+    char* pFileData;
+    glbResult result = glbOpenAndReadTextFile(filePath, &fileSize, &pFileData);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
 
-        // Commands.
-        for (size_t iRequire = 0; iRequire < feature.requires.size(); ++iRequire) {
-            glbResult result = glbBuildGenerateCode_C_Main_RequireCommands(context, feature.requires[iRequire], codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }       
+    result = GLB_ERROR;
+
+    const char* versionBeg = strstr((const char*)pFileData, "glbind - v");
+    if (versionBeg != NULL) {
+        versionBeg += strlen("glbind - v");
+
+        const char* majorEnd    = strchr(versionBeg, '.');
+        const char* minorEnd    = (majorEnd    != NULL) ? strchr(majorEnd + 1, '.')     : NULL;
+        const char* revisionEnd = (minorEnd    != NULL) ? strstr(minorEnd + 1, " - ")   : NULL;
+        const char* dateEnd     = (revisionEnd != NULL) ? strpbrk(revisionEnd + 3, "\r\n") : NULL;
+        if (dateEnd != NULL) {
+            openGLVersionOut = std::string(versionBeg, minorEnd - versionBeg);
+            revisionOut      = std::string(minorEnd + 1, revisionEnd - (minorEnd + 1));
+            dateOut          = std::string(revisionEnd + 3, dateEnd - (revisionEnd + 3));
+            result = GLB_SUCCESS;
         }
     }
-    codeOut += "#endif /* " + feature.name + " */\n";
 
-    return GLB_SUCCESS;
+    free(pFileData);
+    return result;
 }
 
-glbResult glbBuildGenerateCode_C_Main_FeaturesByAPI(glbBuild &context, const char* api, std::string &codeOut)
+glbResult glbBuildGenerateCode_C_Revision(const glbBuild &context, const glbBuildGenerateOptions &options, glbOutput &codeOut)
 {
-    int counter = 0;    // Only used for knowing whether or not a new line should be added.
+    // Rules for the revision number:
+    // 1) If the OpenGL version has changed, reset the revision to 0, otherwise increment by 1.
+    // 2) If glbind.h cannot be found, set to 0.
+    // 3) In deterministic mode, use the revision derived from the inputs. The existing file is never read.
+    if (options.deterministic) {
+        codeOut << options.revision;
+        return GLB_SUCCESS;
+    }
 
-    for (size_t iFeature = 0; iFeature < context.features.size(); ++iFeature) {
-        glbFeature &feature = context.features[iFeature];
-        if (feature.api == api) {
-            if (counter > 0) {
-                codeOut += "\n";
-            }
+    std::string revision = "0";
 
-            glbResult result = glbBuildGenerateCode_C_Main_Feature(context, feature, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+    std::string previousOpenGLVersion;
+    std::string previousRevision;
+    std::string previousDate;
+    if (glbBuildParsePreviousVersion(options.outputFilePath.c_str(), previousOpenGLVersion, previousRevision, previousDate) == GLB_SUCCESS) {
+        std::string currentOpenGLVersion;
+        glbResult result = glbBuildGetOpenGLVersion(context, currentOpenGLVersion);
+        if (result != GLB_SUCCESS) {
+            return result;
+        }
 
-            counter += 1;
+        if (currentOpenGLVersion == previousOpenGLVersion) {
+            // OpenGL versions are the same, so increment.
+            revision = std::to_string(atoi(previousRevision.c_str()) + 1);
         }
     }
 
+    codeOut << revision;
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildGenerateCode_C_Main_Extension(glbBuild &context, glbExtension &extension, std::string &codeOut)
+// The revision used in deterministic mode. This is derived from the hash of everything the output is generated from so that the same
+// inputs always give the same revision, regardless of what's already in the output directory.
+std::string glbBuildGetDeterministicRevision(uint64_t inputHash)
 {
-    codeOut += "#ifndef " + extension.name + "\n";
-    codeOut += "#define " + extension.name + " 1\n";
-    {
-        // Types.
-        for (size_t iRequire = 0; iRequire < extension.requires.size(); ++iRequire) {
-            glbResult result = glbBuildGenerateCode_C_Main_RequireTypes(context, extension.requires[iRequire], codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }       
-        }
+    return std::to_string((unsigned int)(inputHash % 100000));
+}
 
-        // Enums.
-        for (size_t iRequire = 0; iRequire < extension.requires.size(); ++iRequire) {
-            glbResult result = glbBuildGenerateCode_C_Main_RequireEnums(context, extension.requires[iRequire], codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }       
-        }
+// The date used in deterministic mode. This is SOURCE_DATE_EPOCH if it's set, otherwise the epoch. File modification times can't be
+// used since a fresh checkout resets them, which would change the output without any change to the inputs. The date is in UTC so it
+// doesn't depend on the time zone of the machine.
+std::string glbBuildGetDeterministicDate()
+{
+    time_t t = 0;
 
-        // Commands.
-        for (size_t iRequire = 0; iRequire < extension.requires.size(); ++iRequire) {
-            glbResult result = glbBuildGenerateCode_C_Main_RequireCommands(context, extension.requires[iRequire], codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }       
-        }
+    const char* sourceDateEpoch = getenv("SOURCE_DATE_EPOCH");
+    if (sourceDateEpoch != NULL && sourceDateEpoch[0] != '\0') {
+        t = (time_t)strtoll(sourceDateEpoch, NULL, 10);
     }
-    codeOut += "#endif /* " + extension.name + " */\n";
 
-    return GLB_SUCCESS;
+    char dateStr[32];
+#if defined(_MSC_VER)
+    struct tm utc;
+    gmtime_s(&utc, &t);
+#else
+    struct tm utc;
+    gmtime_r(&t, &utc);
+#endif
+    strftime(dateStr, sizeof(dateStr), "%Y-%m-%d", &utc);
+
+    return dateStr;
 }
 
-glbResult glbBuildGenerateCode_C_Main(glbBuild &context, std::string &codeOut)
+glbResult glbBuildGenerateCode_C(const glbBuild &context, const glbBuildGenerateOptions &options, const char* tag, glbOutput &codeOut)
 {
-    glbResult result;
-    int counter;    // Used for tracking whether or not new lines need to be added.
-
-    // Feature order is the following.
-    //  - gl
-    //  - wgl
-    //  - glx
-    result = glbBuildGenerateCode_C_Main_FeaturesByAPI(context, "gl", codeOut);
-    if (result != GLB_SUCCESS) {
-        return result;
+    if (tag == NULL) {
+        return GLB_INVALID_ARGS;
     }
 
-    codeOut += "\n#if defined(GLBIND_WGL)\n";
-    result = glbBuildGenerateCode_C_Main_FeaturesByAPI(context, "wgl", codeOut);
-    if (result != GLB_SUCCESS) {
-        return result;
+    glbResult result = GLB_INVALID_ARGS;
+    if (strcmp(tag, "/*<<opengl_main>>*/") == 0) {
+        result = glbBuildGenerateCode_C_Main(context, codeOut);
     }
-    codeOut += "#endif /* GLBIND_WGL */\n";
-
-    codeOut += "\n#if defined(GLBIND_GLX)\n";
-    result = glbBuildGenerateCode_C_Main_FeaturesByAPI(context, "glx", codeOut);
-    if (result != GLB_SUCCESS) {
-        return result;
+    if (strcmp(tag, "/*<<opengl_funcpointers_decl_global>>*/") == 0) {
+        result = glbBuildGenerateCode_C_FuncPointers(context, true, "extern ", codeOut);
+    }
+    if (strcmp(tag, "/*<<opengl_funcpointers_decl_global:4>>*/") == 0) {
+        result = glbBuildGenerateCode_C_FuncPointers(context, false, "    ", codeOut);
+    }
+    if (strcmp(tag, "/*<<opengl_funcpointers_def_global>>*/") == 0) {
+        result = glbBuildGenerateCode_C_FuncPointers(context, true, "", codeOut);
+    }
+    if (strcmp(tag, "/*<<set_global_api_from_struct>>*/") == 0) {
+        result = glbBuildGenerateCode_C_SetGlobalAPIFromStruct(context, codeOut);
+    }
+    if (strcmp(tag, "/*<<command_names>>*/") == 0) {
+        result = glbBuildGenerateCode_C_CommandNames(context, codeOut);
+    }
+    if (strcmp(tag, "/*<<command_hash>>*/") == 0) {
+        result = glbBuildGenerateCode_C_CommandHash(context, codeOut);
+    }
+    if (strcmp(tag, "/*<<limits>>*/") == 0) {
+        result = glbBuildGenerateCode_C_Limits(context, codeOut);
+    }
+    if (strcmp(tag, "/*<<limit_queries>>*/") == 0) {
+        result = glbBuildGenerateCode_C_LimitQueries(context, codeOut);
+    }
+    if (strcmp(tag, "<<opengl_version>>") == 0) {
+        result = vkbBuildGenerateCode_C_OpenGLVersion(context, codeOut);
+    }
+    if (strcmp(tag, "<<revision>>") == 0) {
+        result = glbBuildGenerateCode_C_Revision(context, options, codeOut);
+    }
+    if (strcmp(tag, "<<date>>") == 0) {
+        if (options.deterministic) {
+            codeOut << options.date;
+            result = GLB_SUCCESS;
+        } else {
+            result = glbBuildGenerateCode_C_Date(context, codeOut);
+        }
     }
-    codeOut += "#endif /* GLBIND_GLX */\n";
 
-    // TODO: All other APIs no in gl, wgl and glx (gles2, etc.)?
+    return result;
+}
+
+struct glbTemplateSegment
+{
+    const char* pText;      // Points into the template data.
+    size_t length;
+    const char* tag;        // NULL if this segment is a run of literal text.
+};
 
+glbResult glbBuildTokenizeTemplate(const char* pTemplate, const char** tags, size_t tagCount, std::vector<glbTemplateSegment> &segments)
+{
+    const char* pLiteralBeg = pTemplate;
+    const char* pRunning = pTemplate;
 
-    // Now we need to do extensions. For cleanliness we want to group extensions. We do gl/glcore first, then wgl, then glx.
-    counter = 0;
-    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
-        glbExtension &extension = context.extensions[iExtension];
-        if (!glbIsExtensionBlackListed(extension.name.c_str()) && (extension.supported == "gl" || glbContains(extension.supported, "gl|") || glbContains(extension.supported, "glcore"))) {
-            if (counter > 0) {
-                codeOut += "\n";
-            }
-            counter += 1;
+    for (;;) {
+        // All tags contain "<<" which means we can jump straight to the next one of those and then check it against each tag.
+        const char* pTagBeg = strstr(pRunning, "<<");
+        if (pTagBeg == NULL) {
+            break;
+        }
 
-            result = glbBuildGenerateCode_C_Main_Extension(context, extension, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
+        // Some tags are wrapped in a comment so that the template is still valid C. The comment is part of the tag.
+        const char* pCandidate = (pTagBeg - pLiteralBeg >= 2 && pTagBeg[-2] == '/' && pTagBeg[-1] == '*') ? pTagBeg - 2 : pTagBeg;
+        const char* tag = NULL;
+        for (size_t iTag = 0; iTag < tagCount; ++iTag) {
+            if (strncmp(pCandidate, tags[iTag], strlen(tags[iTag])) == 0) {
+                tag = tags[iTag];
+                break;
             }
         }
-    }
 
-    // WGL extensions.
-    codeOut += "\n#if defined(GLBIND_WGL)\n";
-    counter = 0;
-    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
-        glbExtension &extension = context.extensions[iExtension];
-        if (!glbIsExtensionBlackListed(extension.name.c_str()) && glbContains(extension.supported, "wgl")) {
-            if (counter > 0) {
-                codeOut += "\n";
-            }
-            counter += 1;
+        if (tag == NULL) {
+            pRunning = pTagBeg + 2;
+            continue;
+        }
 
-            result = glbBuildGenerateCode_C_Main_Extension(context, extension, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+        if (pCandidate > pLiteralBeg) {
+            glbTemplateSegment literal = {pLiteralBeg, (size_t)(pCandidate - pLiteralBeg), NULL};
+            segments.push_back(literal);
         }
-    }
-    codeOut += "#endif /* GLBIND_WGL */\n";
 
-    // GLX extensions.
-    codeOut += "\n#if defined(GLBIND_GLX)\n";
-    counter = 0;
-    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
-        glbExtension &extension = context.extensions[iExtension];
-        if (!glbIsExtensionBlackListed(extension.name.c_str()) && glbContains(extension.supported, "glx")) {
-            if (counter > 0) {
-                codeOut += "\n";
-            }
-            counter += 1;
+        glbTemplateSegment tagSegment = {pCandidate, strlen(tag), tag};
+        segments.push_back(tagSegment);
 
-            result = glbBuildGenerateCode_C_Main_Extension(context, extension, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
-        }
+        pLiteralBeg = pCandidate + strlen(tag);
+        pRunning    = pLiteralBeg;
+    }
+
+    if (*pLiteralBeg != '\0') {
+        glbTemplateSegment literal = {pLiteralBeg, strlen(pLiteralBeg), NULL};
+        segments.push_back(literal);
     }
-    codeOut += "#endif /* GLBIND_GLX */\n";
 
     return GLB_SUCCESS;
 }
 
-
-
-glbResult glbBuildGenerateCode_C_FuncPointersDeclGlobal_RequireCommands(glbBuild &context, int indentation, const glbRequire &require, std::vector<std::string> &processedCommands, std::string &codeOut)
+size_t glbBuildFindTagIndex(const std::vector<const char*> &tags, const char* tag)
 {
-    glbResult result;
+    for (size_t iTag = 0; iTag < tags.size(); ++iTag) {
+        if (strcmp(tags[iTag], tag) == 0) {
+            return iTag;
+        }
+    }
 
-    for (size_t iCommand = 0; iCommand < require.commands.size(); ++iCommand) {
-        std::string commandName = require.commands[iCommand];
-        if (!glbBuildIsCommandIgnored(commandName.c_str()) && std::find(processedCommands.begin(), processedCommands.end(), commandName) == processedCommands.end()) {
-            glbCommand* pCommand;
-            result = glbBuildFindCommand(context, require.commands[iCommand].c_str(), &pCommand);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+    return tags.size();
+}
 
-            for (int i = 0; i < indentation; ++i) {
-                codeOut += " ";
-            }
-            codeOut += "PFN" + glbToUpper(pCommand->name) + "PROC " + pCommand->name + ";\n";
+// Puts together the output from the literal text in the template and the code generated for each tag.
+void glbBuildAssembleOutput(const std::vector<glbTemplateSegment> &segments, const std::vector<const char*> &uniqueTags, const std::vector<glbOutput> &generated, glbOutput &output)
+{
+    output = glbOutput();
 
-            processedCommands.push_back(commandName);
+    for (size_t iSegment = 0; iSegment < segments.size(); ++iSegment) {
+        const glbTemplateSegment &segment = segments[iSegment];
+        if (segment.tag == NULL) {
+            glbOutputAppend(output, segment.pText, segment.length);
+        } else {
+            glbOutputAppendOutput(output, generated[glbBuildFindTagIndex(uniqueTags, segment.tag)]);
         }
     }
-
-    return GLB_SUCCESS;
 }
 
-glbResult glbBuildGenerateCode_C_FuncPointersDeclGlobal_Extension(glbBuild &context, int indentation, const glbExtension &extension, std::vector<std::string> &processedCommands, std::string &codeOut)
+// Splits the template into a header containing only declarations and a source file containing the implementation. The source file
+// includes the header, and both start with the comment at the top of the template and end with the license.
+glbResult glbBuildSplitTemplate(const char* pTemplate, const std::string &headerFileName, std::string &headerOut, std::string &sourceOut)
 {
-    for (size_t iRequire = 0; iRequire < extension.requires.size(); ++iRequire) {
-        glbResult result = glbBuildGenerateCode_C_FuncPointersDeclGlobal_RequireCommands(context, indentation, extension.requires[iRequire], processedCommands, codeOut);
-        if (result != GLB_SUCCESS) {
-            return result;
-        }       
+    const char* pIntroEnd  = strstr(pTemplate, "*/\n");
+    const char* pHeaderEnd = strstr(pTemplate, GLB_BUILD_TEMPLATE_HEADER_END);
+    const char* pImplBeg   = (pHeaderEnd != NULL) ? strstr(pHeaderEnd, GLB_BUILD_TEMPLATE_IMPLEMENTATION_BEG) : NULL;
+    const char* pImplEnd   = (pImplBeg   != NULL) ? strstr(pImplBeg,   GLB_BUILD_TEMPLATE_IMPLEMENTATION_END) : NULL;
+    if (pIntroEnd == NULL || pImplEnd == NULL) {
+        printf("Could not find the implementation section of the template.\n");
+        return GLB_ERROR;
     }
 
+    pIntroEnd  += strlen("*/\n");
+    pHeaderEnd += strlen(GLB_BUILD_TEMPLATE_HEADER_END);
+    const char* pImplBody = pImplBeg + strlen(GLB_BUILD_TEMPLATE_IMPLEMENTATION_BEG);
+    const char* pLicense  = pImplEnd + strlen(GLB_BUILD_TEMPLATE_IMPLEMENTATION_END);
+
+    headerOut.assign(pTemplate, pHeaderEnd);
+    headerOut.append(pLicense);
+
+    sourceOut.assign(pTemplate, pIntroEnd);
+    sourceOut.append("\n#include \"" + headerFileName + "\"\n");
+    sourceOut.append(pHeaderEnd, pImplBeg);     // The banner comment for the implementation section.
+    sourceOut.append(pImplBody, pImplEnd);
+    sourceOut.append(pLicense);
+
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildGenerateCode_C_FuncPointersDeclGlobal_Feature(glbBuild &context, int indentation, const glbFeature &feature, std::vector<std::string> &processedCommands, std::string &codeOut)
+// An output file and the parts of the template it's made from.
+struct glbBuildOutputFile
 {
-    for (size_t iRequire = 0; iRequire < feature.requires.size(); ++iRequire) {
-        glbResult result = glbBuildGenerateCode_C_FuncPointersDeclGlobal_RequireCommands(context, indentation, feature.requires[iRequire], processedCommands, codeOut);
-        if (result != GLB_SUCCESS) {
-            return result;
-        }       
+    std::string path;
+    std::string templateText;
+    std::vector<glbTemplateSegment> segments;
+    glbOutput output;
+};
+
+glbResult glbBuildGenerateOutputFile(const glbBuild &context, const glbBuildGenerateOptions &options)
+{
+    // Before doing anything we need to grab the template.
+    size_t templateFileSize;
+    char* pTemplateFileData;
+    glbResult result = glbOpenAndReadTextFile(options.templateFilePath.c_str(), &templateFileSize, &pTemplateFileData);
+    if (result != GLB_SUCCESS) {
+        return result;
     }
 
-    return GLB_SUCCESS;
-}
+    // The header is always output. The source file is only output when the implementation is split out of the header.
+    std::vector<glbBuildOutputFile> files(options.sourceFilePath.empty() ? 1 : 2);
+    files[0].path = options.outputFilePath;
 
-glbResult glbBuildGenerateCode_C_FuncPointersDeclGlobal(glbBuild &context, int indentation, std::string &codeOut)
-{
-    glbResult result;
-    std::vector<std::string> processedCommands;
-    bool isGlobalScope = (indentation == 0); // If the indentation is 0 it means we're generating the global symbols. Bit of a hack, but it works.
+    if (options.sourceFilePath.empty()) {
+        files[0].templateText = pTemplateFileData;
+    } else {
+        std::string headerFileName = options.outputFilePath.substr(options.outputFilePath.find_last_of("/\\") + 1);  // npos + 1 == 0.
 
-    // GL features.
-    for (size_t iFeature = 0; iFeature < context.features.size(); ++iFeature) {
-        glbFeature &feature = context.features[iFeature];
-        if (feature.api == "gl") {
-            result = glbBuildGenerateCode_C_FuncPointersDeclGlobal_Feature(context, indentation, context.features[iFeature], processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+        files[1].path = options.sourceFilePath;
+        result = glbBuildSplitTemplate(pTemplateFileData, headerFileName, files[0].templateText, files[1].templateText);
+    }
+
+    free(pTemplateFileData);
+    if (result != GLB_SUCCESS) {
+        return result;
+    }
+
+    // There will be a series of tags that we need to replace with generated code.
+    const char* tags[] = {
+        "/*<<opengl_main>>*/",
+        "/*<<opengl_funcpointers_decl_global>>*/",
+        "/*<<opengl_funcpointers_decl_global:4>>*/",
+        "/*<<opengl_funcpointers_def_global>>*/",
+        "/*<<set_global_api_from_struct>>*/",
+        "/*<<command_names>>*/",
+        "/*<<command_hash>>*/",
+        "/*<<limits>>*/",
+        "/*<<limit_queries>>*/",
+        "<<opengl_version>>",
+        "<<revision>>",
+        "<<date>>",
+    };
+
+    // The template is split into literal text and tags in a single pass. The output is then built in one go, with the code for each tag
+    // being generated straight into the output.
+    for (size_t iFile = 0; iFile < files.size(); ++iFile) {
+        result = glbBuildTokenizeTemplate(files[iFile].templateText.c_str(), tags, sizeof(tags)/sizeof(tags[0]), files[iFile].segments);
+        if (result != GLB_SUCCESS) {
+            return result;
         }
     }
 
-    // NOTE: Some headers define their own symbols for some APIs, such as the common WGL functions (wglCreateContext, etc.). This causes compiler errors
-    // so I'm working around this by simply not outputting them to global scope. We do, however, need these to be included in the GLBapi structure.
+    glbBuildStatsEndPhase(options.pStats, "read template");
 
-    // WGL features.
-    if (!isGlobalScope) {
-        codeOut += "#if defined(GLBIND_WGL)\n";
-        for (size_t iFeature = 0; iFeature < context.features.size(); ++iFeature) {
-            glbFeature &feature = context.features[iFeature];
-            if (feature.api == "wgl") {
-                result = glbBuildGenerateCode_C_FuncPointersDeclGlobal_Feature(context, indentation, context.features[iFeature], processedCommands, codeOut);
-                if (result != GLB_SUCCESS) {
-                    return result;
-                }
+    // Each distinct tag is generated once into its own buffer. Tags only read from the registry so they can be generated in parallel.
+    std::vector<const char*> uniqueTags;
+    for (size_t iFile = 0; iFile < files.size(); ++iFile) {
+        for (size_t iSegment = 0; iSegment < files[iFile].segments.size(); ++iSegment) {
+            const char* tag = files[iFile].segments[iSegment].tag;
+            if (tag != NULL && std::find(uniqueTags.begin(), uniqueTags.end(), tag) == uniqueTags.end()) {
+                uniqueTags.push_back(tag);
             }
         }
-        codeOut += "#endif /* GLBIND_WGL */\n";
     }
 
-    if (!isGlobalScope) {
-        codeOut += "#if defined(GLBIND_GLX)\n";
-        for (size_t iFeature = 0; iFeature < context.features.size(); ++iFeature) {
-            glbFeature &feature = context.features[iFeature];
-            if (feature.api == "glx") {
-                result = glbBuildGenerateCode_C_FuncPointersDeclGlobal_Feature(context, indentation, context.features[iFeature], processedCommands, codeOut);
-                if (result != GLB_SUCCESS) {
-                    return result;
+    std::vector<glbOutput> generated(uniqueTags.size());
+    std::vector<glbResult> results(uniqueTags.size(), GLB_SUCCESS);
+    std::vector<double> tagMS(uniqueTags.size(), 0);
+    {
+        std::atomic<size_t> nextTag(0);
+        std::vector<std::thread> threads;
+
+        size_t threadCount = std::min((size_t)std::max(std::thread::hardware_concurrency(), 1U), uniqueTags.size());
+        for (size_t iThread = 0; iThread < threadCount; ++iThread) {
+            threads.emplace_back([&]() {
+                for (size_t iTag = nextTag++; iTag < uniqueTags.size(); iTag = nextTag++) {
+                    std::chrono::steady_clock::time_point tagStart = std::chrono::steady_clock::now();
+                    results[iTag] = glbBuildGenerateCode_C(context, options, uniqueTags[iTag], generated[iTag]);
+                    tagMS[iTag] = glbElapsedMS(tagStart);
                 }
-            }
+            });
         }
-        codeOut += "#endif /* GLBIND_GLX */\n";
-    }
 
-    // GL extensions.
-    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
-        glbExtension &extension = context.extensions[iExtension];
-        if (!glbIsExtensionBlackListed(extension.name.c_str()) && (extension.supported == "gl" || glbContains(extension.supported, "gl|") || glbContains(extension.supported, "glcore"))) {
-            result = glbBuildGenerateCode_C_FuncPointersDeclGlobal_Extension(context, indentation, extension, processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+        for (size_t iThread = 0; iThread < threads.size(); ++iThread) {
+            threads[iThread].join();
         }
     }
 
-    // WGL extensions.
-    codeOut += "#if defined(GLBIND_WGL)\n";
-    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
-        glbExtension &extension = context.extensions[iExtension];
-        if (!glbIsExtensionBlackListed(extension.name.c_str()) && glbContains(extension.supported, "wgl")) {
-            result = glbBuildGenerateCode_C_FuncPointersDeclGlobal_Extension(context, indentation, extension, processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+    for (size_t iTag = 0; iTag < uniqueTags.size(); ++iTag) {
+        if (results[iTag] != GLB_SUCCESS) {
+            return results[iTag];
         }
     }
-    codeOut += "#endif /* GLBIND_WGL */\n";
 
-    // GLX extensions.
-    codeOut += "#if defined(GLBIND_GLX)\n";
-    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
-        glbExtension &extension = context.extensions[iExtension];
-        if (!glbIsExtensionBlackListed(extension.name.c_str()) && glbContains(extension.supported, "glx")) {
-            result = glbBuildGenerateCode_C_FuncPointersDeclGlobal_Extension(context, indentation, extension, processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+    // The tags are generated in parallel so the time for each one can add up to more than the time for all of them.
+    glbBuildStatsEndPhase(options.pStats, "generate tags");
+    for (size_t iTag = 0; iTag < uniqueTags.size(); ++iTag) {
+        glbBuildStatsAddPhase(options.pStats, uniqueTags[iTag], tagMS[iTag], 1);
+    }
+
+    // Now the output can be put together in template order.
+    for (size_t iFile = 0; iFile < files.size(); ++iFile) {
+        glbBuildAssembleOutput(files[iFile].segments, uniqueTags, generated, files[iFile].output);
+
+        bool isWritten;
+        result = glbOutputWriteToFilePathIfChanged(files[iFile].output, files[iFile].path.c_str(), &isWritten);
+        if (result != GLB_SUCCESS) {
+            return result;
+        }
+
+        if (!isWritten && options.deterministic) {
+            printf("%s is unchanged.\n", files[iFile].path.c_str());
         }
     }
-    codeOut += "#endif /* GLBIND_GLX */";
+
+    glbBuildStatsEndPhase(options.pStats, "assemble and write");
 
     return GLB_SUCCESS;
 }
 
 
-glbResult glbBuildGenerateCode_C_InitCurrentContextAPI_RequireCommands(glbBuild &context, const glbRequire &require, std::vector<std::string> &processedCommands, std::string &codeOut)
+void glbBuildPrintUsage()
 {
-    glbResult result;
+    printf("Usage: glbind_build [options]\n");
+    printf("\n");
+    printf("Selection. By default everything in the registry for desktop OpenGL is output.\n");
+    printf("  --api <name>           The API to output, e.g. \"gl\" or \"gles2\". Defaults to \"gl\".\n");
+    printf("  --max-version <x.y>    Exclude features above this version.\n");
+    printf("  --profile <profile>    \"core\" or \"compatibility\". In the core profile, anything removed from core is excluded.\n");
+    printf("  --extensions <list>    Comma separated list of extensions to output. Can be used more than once. An empty list\n");
+    printf("                         outputs no extensions. Defaults to all extensions.\n");
+    printf("  --platforms <list>     Comma separated list of platforms: \"wgl\" and/or \"glx\". Defaults to both.\n");
+    printf("\n");
+    printf("Files. Relative paths are relative to the working directory.\n");
+    printf("  --registry <dir>       Directory containing gl.xml, wgl.xml and glx.xml. Defaults to %s.\n", GLB_BUILD_REGISTRY_PATH);
+    printf("  --template <file>      Defaults to %s.\n", GLB_BUILD_TEMPLATE_PATH);
+    printf("  --output <file>        Defaults to %s.\n", GLB_BUILD_OUTPUT_PATH);
+    printf("  --source <file>        Output the implementation to this file instead of the header. The header will then only\n");
+    printf("                         contain declarations and the source file needs to be compiled with the rest of the program.\n");
+    printf("  --manifest <file>      Generate several variants from a single load of the registry. Each line of the file is the\n");
+    printf("                         selection and file options for one variant, which must include --output. Options given on\n");
+    printf("                         the command line are the defaults for every variant.\n");
+    printf("\n");
+    printf("Other.\n");
+    printf("  --deterministic        Derive the revision from the inputs rather than the existing output file, and take\n");
+    printf("                         the date from SOURCE_DATE_EPOCH rather than the clock. Without it, the date is\n");
+    printf("                         1970-01-01.\n");
+    printf("  --cache <file>         The registry cache. Defaults to %s in the same directory as --output.\n", GLB_BUILD_CACHE_NAME);
+    printf("  --no-cache             Don't read or write the registry cache.\n");
+    printf("  --dom                  Load the registry with the reference tinyxml2 loader. Implies --no-cache.\n");
+    printf("  --verify-parser        Load the registry with both loaders, compare them and exit. Implies --no-cache.\n");
+    printf("  --stats                Output the size of the registry and the time taken by each phase.\n");
+    printf("  --help                 Show this message.\n");
+}
 
-    for (size_t iCommand = 0; iCommand < require.commands.size(); ++iCommand) {
-        std::string commandName = require.commands[iCommand];
-        if (!glbBuildIsCommandIgnored(commandName.c_str()) && std::find(processedCommands.begin(), processedCommands.end(), commandName) == processedCommands.end()) {
-            glbCommand* pCommand;
-            result = glbBuildFindCommand(context, require.commands[iCommand].c_str(), &pCommand);
+// A header to generate, along with its source file if the implementation is split out. There's one of these for each line of the
+// manifest, or just the one when there's no manifest.
+struct glbBuildVariant
+{
+    glbBuildSelection selection;
+    glbBuildGenerateOptions generateOptions;
+    glbBuildStats stats;
+};
+
+// Hashes the content of the output files of every variant, which is the header followed by the source file if there is one.
+glbResult glbBuildHashOutputFiles(const std::vector<glbBuildVariant> &variants, uint64_t* pHash)
+{
+    *pHash = GLB_HASH_INIT;
+    for (size_t iVariant = 0; iVariant < variants.size(); ++iVariant) {
+        const glbBuildGenerateOptions &options = variants[iVariant].generateOptions;
+
+        glbResult result = glbHashFile(*pHash, options.outputFilePath.c_str(), pHash);
+        if (result != GLB_SUCCESS) {
+            return result;
+        }
+
+        if (!options.sourceFilePath.empty()) {
+            result = glbHashFile(*pHash, options.sourceFilePath.c_str(), pHash);
             if (result != GLB_SUCCESS) {
                 return result;
             }
-
-            codeOut += "    pAPI->" + pCommand->name + " = (PFN" + glbToUpper(pCommand->name) + "PROC)glbGetProcAddress(\"" + pCommand->name + "\");\n";
-
-            processedCommands.push_back(commandName);
         }
     }
 
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildGenerateCode_C_InitCurrentContextAPI_Feature(glbBuild &context, const glbFeature &feature, std::vector<std::string> &processedCommands, std::string &codeOut)
+// Hashes the selection of a variant. The extensions are in a set so they're sorted first to get the same hash regardless of the order
+// they were listed in.
+uint64_t glbBuildHashSelection(uint64_t hash, const glbBuildSelection &selection)
 {
-    for (size_t iRequire = 0; iRequire < feature.requires.size(); ++iRequire) {
-        glbResult result = glbBuildGenerateCode_C_InitCurrentContextAPI_RequireCommands(context, feature.requires[iRequire], processedCommands, codeOut);
-        if (result != GLB_SUCCESS) {
-            return result;
-        }
+    std::vector<std::string> extensions(selection.extensions.begin(), selection.extensions.end());
+    std::sort(extensions.begin(), extensions.end());
+
+    const std::string* strings[] = { &selection.api, &selection.maxVersion, &selection.profile };
+    for (size_t iString = 0; iString < sizeof(strings)/sizeof(strings[0]); ++iString) {
+        hash = glbHash(hash, strings[iString]->c_str(), strings[iString]->size() + 1);
     }
 
-    return GLB_SUCCESS;
-}
+    const bool flags[] = { selection.allExtensions, selection.wgl, selection.glx };
+    hash = glbHash(hash, flags, sizeof(flags));
 
-glbResult glbBuildGenerateCode_C_InitCurrentContextAPI_Extension(glbBuild &context, const glbExtension &extension, std::vector<std::string> &processedCommands, std::string &codeOut)
-{
-    for (size_t iRequire = 0; iRequire < extension.requires.size(); ++iRequire) {
-        glbResult result = glbBuildGenerateCode_C_InitCurrentContextAPI_RequireCommands(context, extension.requires[iRequire], processedCommands, codeOut);
-        if (result != GLB_SUCCESS) {
-            return result;
-        }
+    uint64_t extensionCount = (uint64_t)extensions.size();
+    hash = glbHash(hash, &extensionCount, sizeof(extensionCount));
+    for (size_t iExtension = 0; iExtension < extensions.size(); ++iExtension) {
+        hash = glbHash(hash, extensions[iExtension].c_str(), extensions[iExtension].size() + 1);
     }
 
-    return GLB_SUCCESS;
+    return hash;
 }
 
-glbResult glbBuildGenerateCode_C_InitCurrentContextAPI(glbBuild &context, std::string &codeOut)
+// Hashes everything about a variant that affects what's written to its output files. This is what the cache is keyed on rather than
+// the command line, so the order of options and options that don't change the output don't cause the registry to be reloaded. The
+// content of the template is hashed separately.
+uint64_t glbBuildHashVariant(uint64_t hash, const glbBuildVariant &variant)
 {
-    glbResult result;
-    std::vector<std::string> processedCommands;
-
-    // GL features.
-    for (size_t iFeature = 0; iFeature < context.features.size(); ++iFeature) {
-        glbFeature &feature = context.features[iFeature];
-        if (feature.api == "gl") {
-            result = glbBuildGenerateCode_C_InitCurrentContextAPI_Feature(context, context.features[iFeature], processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
-        }
-    }
+    const glbBuildGenerateOptions &options = variant.generateOptions;
 
-    // WGL features.
-    codeOut += "#if defined(GLBIND_WGL)\n";
-    for (size_t iFeature = 0; iFeature < context.features.size(); ++iFeature) {
-        glbFeature &feature = context.features[iFeature];
-        if (feature.api == "wgl") {
-            result = glbBuildGenerateCode_C_InitCurrentContextAPI_Feature(context, context.features[iFeature], processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
-        }
-    }
-    codeOut += "#endif /* GLBIND_WGL */\n";
+    hash = glbBuildHashSelection(hash, variant.selection);
 
-    // GLX features.
-    codeOut += "#if defined(GLBIND_GLX)\n";
-    for (size_t iFeature = 0; iFeature < context.features.size(); ++iFeature) {
-        glbFeature &feature = context.features[iFeature];
-        if (feature.api == "glx") {
-            result = glbBuildGenerateCode_C_InitCurrentContextAPI_Feature(context, context.features[iFeature], processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
-        }
+    const std::string* strings[] = { &options.templateFilePath, &options.outputFilePath, &options.sourceFilePath };
+    for (size_t iString = 0; iString < sizeof(strings)/sizeof(strings[0]); ++iString) {
+        hash = glbHash(hash, strings[iString]->c_str(), strings[iString]->size() + 1);
     }
-    codeOut += "#endif /* GLBIND_GLX */\n";
 
+    hash = glbHash(hash, &options.deterministic, sizeof(options.deterministic));
+    return hash;
+}
 
-    // GL extensions.
-    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
-        glbExtension &extension = context.extensions[iExtension];
-        if (!glbIsExtensionBlackListed(extension.name.c_str()) && (extension.supported == "gl" || glbContains(extension.supported, "gl|") || glbContains(extension.supported, "glcore"))) {
-            result = glbBuildGenerateCode_C_InitCurrentContextAPI_Extension(context, extension, processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
-        }
+// Retrieves the default path of the cache, which is in the same directory as the output file.
+std::string glbBuildGetDefaultCachePath(const std::string &outputFilePath)
+{
+    size_t separator = outputFilePath.find_last_of("/\\");
+    if (separator == std::string::npos) {
+        return GLB_BUILD_CACHE_NAME;
     }
 
-    // WGL extensions.
-    codeOut += "#if defined(GLBIND_WGL)\n";
-    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
-        glbExtension &extension = context.extensions[iExtension];
-        if (!glbIsExtensionBlackListed(extension.name.c_str()) && glbContains(extension.supported, "wgl")) {
-            result = glbBuildGenerateCode_C_InitCurrentContextAPI_Extension(context, extension, processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+    return outputFilePath.substr(0, separator + 1) + GLB_BUILD_CACHE_NAME;
+}
+
+// Splits a comma separated list and inserts each item into a set. Empty items are ignored.
+void glbSplitList(const char* list, std::unordered_set<std::string> &items)
+{
+    std::string str = list;
+    size_t beg = 0;
+    for (;;) {
+        size_t end = str.find(',', beg);
+        std::string item = glbTrim(str.substr(beg, (end == std::string::npos) ? std::string::npos : end - beg));
+        if (!item.empty()) {
+            items.insert(item);
         }
-    }
-    codeOut += "#endif /* GLBIND_WGL */\n";
 
-    // GLX extensions.
-    codeOut += "#if defined(GLBIND_GLX)\n";
-    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
-        glbExtension &extension = context.extensions[iExtension];
-        if (!glbIsExtensionBlackListed(extension.name.c_str()) && glbContains(extension.supported, "glx")) {
-            result = glbBuildGenerateCode_C_InitCurrentContextAPI_Extension(context, extension, processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+        if (end == std::string::npos) {
+            break;
         }
-    }
-    codeOut += "#endif /* GLBIND_GLX */";
 
-    return GLB_SUCCESS;
+        beg = end + 1;
+    }
 }
 
-
-glbResult glbBuildGenerateCode_C_SetGlobalAPIFromStruct_RequireCommands(glbBuild &context, const glbRequire &require, std::vector<std::string> &processedCommands, std::string &codeOut)
+// Splits a line of the manifest into arguments. Arguments are separated by whitespace, and can be put in double quotes to include
+// whitespace or to pass an empty argument.
+void glbSplitArgs(const std::string &line, std::vector<std::string> &args)
 {
-    glbResult result;
+    size_t pos = 0;
+    for (;;) {
+        while (pos < line.size() && isspace((unsigned char)line[pos])) {
+            pos += 1;
+        }
 
-    for (size_t iCommand = 0; iCommand < require.commands.size(); ++iCommand) {
-        std::string commandName = require.commands[iCommand];
-        if (!glbBuildIsCommandIgnored(commandName.c_str()) && std::find(processedCommands.begin(), processedCommands.end(), commandName) == processedCommands.end()) {
-            glbCommand* pCommand;
-            result = glbBuildFindCommand(context, require.commands[iCommand].c_str(), &pCommand);
-            if (result != GLB_SUCCESS) {
-                return result;
+        if (pos == line.size()) {
+            break;
+        }
+
+        std::string arg;
+        if (line[pos] == '"') {
+            size_t end = line.find('"', pos + 1);
+            if (end == std::string::npos) {
+                end = line.size();
             }
 
-            codeOut += "    " + pCommand->name + " = pAPI->" + pCommand->name + ";\n";
+            arg = line.substr(pos + 1, end - pos - 1);
+            pos = std::min(end + 1, line.size());
+        } else {
+            size_t end = pos;
+            while (end < line.size() && !isspace((unsigned char)line[end])) {
+                end += 1;
+            }
 
-            processedCommands.push_back(commandName);
+            arg = line.substr(pos, end - pos);
+            pos = end;
         }
-    }
 
-    return GLB_SUCCESS;
+        args.push_back(arg);
+    }
 }
 
-glbResult glbBuildGenerateCode_C_SetGlobalAPIFromStruct_Feature(glbBuild &context, const glbFeature &feature, std::vector<std::string> &processedCommands, std::string &codeOut)
+bool glbBuildIsOptionWithValue(const char* arg)
 {
-    for (size_t iRequire = 0; iRequire < feature.requires.size(); ++iRequire) {
-        glbResult result = glbBuildGenerateCode_C_SetGlobalAPIFromStruct_RequireCommands(context, feature.requires[iRequire], processedCommands, codeOut);
-        if (result != GLB_SUCCESS) {
-            return result;
+    const char* options[] = {
+        "--api", "--max-version", "--profile", "--extensions", "--platforms", "--registry", "--template", "--output", "--source", "--manifest",
+        "--cache"
+    };
+
+    for (size_t iOption = 0; iOption < sizeof(options)/sizeof(options[0]); ++iOption) {
+        if (strcmp(arg, options[iOption]) == 0) {
+            return true;
         }
     }
 
-    return GLB_SUCCESS;
+    return false;
 }
 
-glbResult glbBuildGenerateCode_C_SetGlobalAPIFromStruct_Extension(glbBuild &context, const glbExtension &extension, std::vector<std::string> &processedCommands, std::string &codeOut)
+// Handles the options that can be different for each variant. pHandled is set to false if the option is not one of them.
+glbResult glbBuildParseVariantOption(const char* arg, const char* value, glbBuildVariant &variant, bool* pHandled)
 {
-    for (size_t iRequire = 0; iRequire < extension.requires.size(); ++iRequire) {
-        glbResult result = glbBuildGenerateCode_C_SetGlobalAPIFromStruct_RequireCommands(context, extension.requires[iRequire], processedCommands, codeOut);
-        if (result != GLB_SUCCESS) {
-            return result;
+    glbBuildSelection &selection = variant.selection;
+    glbBuildGenerateOptions &generateOptions = variant.generateOptions;
+
+    *pHandled = true;
+
+    if (strcmp(arg, "--api") == 0) {
+        selection.api = value;
+    } else if (strcmp(arg, "--max-version") == 0) {
+        selection.maxVersion = value;
+    } else if (strcmp(arg, "--profile") == 0) {
+        selection.profile = (strcmp(value, "compat") == 0) ? "compatibility" : value;
+    } else if (strcmp(arg, "--extensions") == 0) {
+        selection.allExtensions = false;
+        glbSplitList(value, selection.extensions);
+    } else if (strcmp(arg, "--platforms") == 0) {
+        std::unordered_set<std::string> platforms;
+        glbSplitList(value, platforms);
+
+        selection.wgl = platforms.erase("wgl") > 0;
+        selection.glx = platforms.erase("glx") > 0;
+        if (platforms.erase("egl") > 0) {
+            printf("EGL is not supported. glbind creates its rendering context with WGL or GLX.\n");
+            return GLB_INVALID_ARGS;
         }
+        if (!platforms.empty()) {
+            printf("Unknown platform: %s\n", platforms.begin()->c_str());
+            return GLB_INVALID_ARGS;
+        }
+    } else if (strcmp(arg, "--template") == 0) {
+        generateOptions.templateFilePath = value;
+    } else if (strcmp(arg, "--output") == 0) {
+        generateOptions.outputFilePath = value;
+    } else if (strcmp(arg, "--source") == 0) {
+        generateOptions.sourceFilePath = value;
+    } else {
+        *pHandled = false;
     }
 
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildGenerateCode_C_SetGlobalAPIFromStruct(glbBuild &context, std::string &codeOut)
+// Loads the variants from a manifest. Each line is a list of options for one variant, starting from the defaults. Empty lines and
+// lines starting with # are ignored.
+glbResult glbBuildLoadManifest(const char* filePath, const glbBuildVariant &defaults, std::vector<glbBuildVariant> &variants)
 {
-    glbResult result;
-    std::vector<std::string> processedCommands;
+    size_t fileSize;
+    char* pFileData;
+    glbResult result = glbOpenAndReadTextFile(filePath, &fileSize, &pFileData);
+    if (result != GLB_SUCCESS) {
+        printf("Failed to open %s\n", filePath);
+        return result;
+    }
 
-    // GL features.
-    for (size_t iFeature = 0; iFeature < context.features.size(); ++iFeature) {
-        glbFeature &feature = context.features[iFeature];
-        if (feature.api == "gl") {
-            result = glbBuildGenerateCode_C_SetGlobalAPIFromStruct_Feature(context, context.features[iFeature], processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
-            }
+    std::string text = pFileData;
+    free(pFileData);
+
+    size_t lineBeg = 0;
+    for (int lineNumber = 1; lineBeg < text.size(); ++lineNumber) {
+        size_t lineEnd = text.find('\n', lineBeg);
+        if (lineEnd == std::string::npos) {
+            lineEnd = text.size();
         }
-    }
 
-    // Some system APIs should not be bound to global scope because they declare their functions statically.
-#if 0
-    // WGL features.
+        std::string line = glbTrim(text.substr(lineBeg, lineEnd - lineBeg));
+        lineBeg = lineEnd + 1;
 
-    // GLX features.
-#endif
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
 
-    // GL extensions.
-    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
-        glbExtension &extension = context.extensions[iExtension];
-        if (!glbIsExtensionBlackListed(extension.name.c_str()) && (extension.supported == "gl" || glbContains(extension.supported, "gl|") || glbContains(extension.supported, "glcore"))) {
-            result = glbBuildGenerateCode_C_SetGlobalAPIFromStruct_Extension(context, extension, processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
+        std::vector<std::string> args;
+        glbSplitArgs(line, args);
+
+        glbBuildVariant variant = defaults;
+        bool hasOutput = false;
+        for (size_t iArg = 0; iArg < args.size(); ++iArg) {
+            const char* arg = args[iArg].c_str();
+            const char* value = NULL;
+            if (glbBuildIsOptionWithValue(arg)) {
+                if (iArg + 1 == args.size()) {
+                    printf("%s(%d): Missing value for %s\n", filePath, lineNumber, arg);
+                    return GLB_INVALID_ARGS;
+                }
+
+                value = args[++iArg].c_str();
             }
-        }
-    }
 
-    // WGL extensions.
-    codeOut += "#if defined(GLBIND_WGL)\n";
-    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
-        glbExtension &extension = context.extensions[iExtension];
-        if (!glbIsExtensionBlackListed(extension.name.c_str()) && glbContains(extension.supported, "wgl")) {
-            result = glbBuildGenerateCode_C_SetGlobalAPIFromStruct_Extension(context, extension, processedCommands, codeOut);
+            bool isHandled;
+            result = glbBuildParseVariantOption(arg, value, variant, &isHandled);
             if (result != GLB_SUCCESS) {
                 return result;
             }
-        }
-    }
-    codeOut += "#endif /* GLBIND_WGL */\n";
 
-    // GLX extensions.
-    codeOut += "#if defined(GLBIND_GLX)\n";
-    for (size_t iExtension = 0; iExtension < context.extensions.size(); ++iExtension) {
-        glbExtension &extension = context.extensions[iExtension];
-        if (!glbIsExtensionBlackListed(extension.name.c_str()) && glbContains(extension.supported, "glx")) {
-            result = glbBuildGenerateCode_C_SetGlobalAPIFromStruct_Extension(context, extension, processedCommands, codeOut);
-            if (result != GLB_SUCCESS) {
-                return result;
+            if (!isHandled) {
+                printf("%s(%d): %s can't be used in a manifest.\n", filePath, lineNumber, arg);
+                return GLB_INVALID_ARGS;
             }
+
+            hasOutput = hasOutput || strcmp(arg, "--output") == 0;
         }
-    }
-    codeOut += "#endif /* GLBIND_GLX */";
 
-    return GLB_SUCCESS;
-}
+        if (!hasOutput) {
+            printf("%s(%d): Each variant needs an --output.\n", filePath, lineNumber);
+            return GLB_INVALID_ARGS;
+        }
 
-#include <time.h>
-glbResult glbBuildGenerateCode_C_Date(glbBuild &context, std::string &codeOut)
-{
-    (void)context;
+        variants.push_back(variant);
+    }
 
-    time_t t = time(NULL);
+    if (variants.empty()) {
+        printf("%s has no variants.\n", filePath);
+        return GLB_INVALID_ARGS;
+    }
 
-    char dateStr[32];
-#if defined(_MSC_VER)
-    struct tm local;
-    localtime_s(&local, &t);
-    strftime(dateStr, sizeof(dateStr), "%Y-%m-%d", &local);
-#else
-    struct tm *local = localtime(&t);
-    strftime(dateStr, sizeof(dateStr), "%Y-%m-%d", local);
-#endif
+    // Variants are generated in parallel so they can't share any output files.
+    std::unordered_set<std::string> outputFilePaths;
+    for (size_t iVariant = 0; iVariant < variants.size(); ++iVariant) {
+        const glbBuildGenerateOptions &options = variants[iVariant].generateOptions;
+        if (!outputFilePaths.insert(options.outputFilePath).second || (!options.sourceFilePath.empty() && !outputFilePaths.insert(options.sourceFilePath).second)) {
+            printf("%s: More than one variant outputs to the same file.\n", filePath);
+            return GLB_INVALID_ARGS;
+        }
+    }
 
-    codeOut += dateStr;
     return GLB_SUCCESS;
 }
 
-glbResult glbBuildGetOpenGLVersion(glbBuild &context, std::string &versionOut)
+// Trims the registry down to the selection of a variant and generates its output files. The registry must not have been indexed yet.
+glbResult glbBuildGenerateVariant(glbBuild &context, const glbBuildVariant &variant)
 {
-    // The version can be retrieved from the last "gl" feature section.
-    std::string versionStr;
-    for (auto feature : context.features) {
-        if (feature.api == "gl") {
-            versionStr = feature.number;
-        }
+    glbResult result = glbBuildApplySelection(context, variant.selection);
+    if (result != GLB_SUCCESS) {
+        return result;
     }
 
-    versionOut = versionStr;
-
-    return GLB_SUCCESS;
-}
+    glbBuildStatsEndPhase(variant.generateOptions.pStats, "apply selection");
 
-glbResult vkbBuildGenerateCode_C_OpenGLVersion(glbBuild &context, std::string &codeOut)
-{
-    std::string version;
-    glbResult result = glbBuildGetOpenGLVersion(context, version);
+    // Lookups by name are done through hash tables which need to be built now that everything has been loaded.
+    result = glbBuildIndexRegistry(context);
     if (result != GLB_SUCCESS) {
         return result;
     }
 
-    codeOut += version;
+    glbBuildStatsEndPhase(variant.generateOptions.pStats, "index registry");
 
-    return GLB_SUCCESS;
+    result = glbBuildGenerateOutputFile(context, variant.generateOptions);
+    if (result != GLB_SUCCESS) {
+        printf("Failed to generate %s.\n", variant.generateOptions.outputFilePath.c_str());
+    }
+
+    return result;
 }
 
-glbResult glbBuildGenerateCode_C_Revision(glbBuild &context, std::string &codeOut)
+int main(int argc, char** argv)
 {
-    // Rules for the revision number:
-    // 1) If the OpenGL version has changed, reset the revision to 0, otherwise increment by 1.
-    // 2) If glbind.h cannot be found, set to 0.
-    std::string revision;
+    glbBuild context;
+    glbResult result;
 
-    size_t fileSize;
-    char* pFileData;
-    if (glbOpenAndReadTextFile("../../glbind.h", &fileSize, &pFileData) == GLB_SUCCESS) {
-        // We need to parse the previous version.
-        std::string prevVersionMajor;
-        std::string prevVersionMinor;
-        std::string prevVersionRevision;
-        const char* versionBeg = strstr((const char*)pFileData, "glbind - v");
-        if (versionBeg != NULL) {
-            versionBeg += strlen("glbind - v");
-
-            std::string currentOpenGLVersion;
-            glbResult result = glbBuildGetOpenGLVersion(context, currentOpenGLVersion);
-            if (result != GLB_SUCCESS) {
-                return result;
+    glbBuildVariant defaults;
+    std::string registryDirectory = GLB_BUILD_REGISTRY_PATH;
+    std::string manifestFilePath;
+    std::string cacheFilePath;
+    bool useDOM = false;
+    bool verifyParser = false;
+    bool useCache = true;
+    bool outputStats = false;
+    glbBuildStats stats;
+
+    for (int iArg = 1; iArg < argc; ++iArg) {
+        const char* arg = argv[iArg];
+
+        // Options taking a value.
+        const char* value = NULL;
+        if (glbBuildIsOptionWithValue(arg)) {
+            if (iArg + 1 == argc) {
+                printf("Missing value for %s\n", arg);
+                return GLB_INVALID_ARGS;
             }
 
-            const char* cursorBeg = versionBeg;
-            const char* cursorEnd = versionBeg;
-
-            cursorEnd = strstr(cursorBeg, ".");
-            prevVersionMajor = std::string(cursorBeg, cursorEnd-cursorBeg);
-            cursorBeg = cursorEnd + 1;
+            value = argv[++iArg];
+        }
 
-            cursorEnd = strstr(cursorBeg, ".");
-            prevVersionMinor = std::string(cursorBeg, cursorEnd-cursorBeg);
-            cursorBeg = cursorEnd + 1;
+        bool isVariantOption;
+        result = glbBuildParseVariantOption(arg, value, defaults, &isVariantOption);
+        if (result != GLB_SUCCESS) {
+            return result;
+        }
 
-            cursorEnd = strstr(cursorBeg, " ");
-            prevVersionRevision = std::string(cursorBeg, cursorEnd-cursorBeg);
-            cursorBeg = cursorEnd + 1;
+        if (isVariantOption) {
+            continue;
+        }
 
-            std::string previousOpenGLVersion = prevVersionMajor + "." + prevVersionMinor;
-            if (currentOpenGLVersion == previousOpenGLVersion) {
-                // OpenGL versions are the same, so increment.
-                revision = std::to_string(atoi(prevVersionRevision.c_str()) + 1);
-            } else {
-                // OpenGL versions are different, so reset.
-                revision = "0";
-            }
+        if (strcmp(arg, "--registry") == 0) {
+            registryDirectory = value;
+        } else if (strcmp(arg, "--manifest") == 0) {
+            manifestFilePath = value;
+        } else if (strcmp(arg, "--cache") == 0) {
+            cacheFilePath = value;
+        } else if (strcmp(arg, "--deterministic") == 0) {
+            defaults.generateOptions.deterministic = true;
+        } else if (strcmp(arg, "--dom") == 0) {
+            useDOM = true;
+            useCache = false;
+        } else if (strcmp(arg, "--verify-parser") == 0) {
+            verifyParser = true;
+            useCache = false;
+        } else if (strcmp(arg, "--no-cache") == 0) {
+            useCache = false;
+        } else if (strcmp(arg, "--stats") == 0) {
+            outputStats = true;
+        } else if (strcmp(arg, "--help") == 0) {
+            glbBuildPrintUsage();
+            return 0;
         } else {
-            // Couldn't find the previous version.
-            revision = "0";
+            printf("Unknown argument: %s\n", arg);
+            glbBuildPrintUsage();
+            return GLB_INVALID_ARGS;
         }
-    } else {
-        // vkbind.h was not found.
-        revision = "0";
     }
 
-    codeOut += revision;
-    return GLB_SUCCESS;
-}
-
-glbResult glbBuildGenerateCode_C(glbBuild &context, const char* tag, std::string &codeOut)
-{
-    if (tag == NULL) {
-        return GLB_INVALID_ARGS;
+    std::vector<glbBuildVariant> variants;
+    if (manifestFilePath.empty()) {
+        variants.push_back(defaults);
+    } else {
+        result = glbBuildLoadManifest(manifestFilePath.c_str(), defaults, variants);
+        if (result != GLB_SUCCESS) {
+            return result;
+        }
     }
 
-    glbResult result = GLB_INVALID_ARGS;
-    if (strcmp(tag, "/*<<opengl_main>>*/") == 0) {
-        result = glbBuildGenerateCode_C_Main(context, codeOut);
-    }
-    if (strcmp(tag, "/*<<opengl_funcpointers_decl_global>>*/") == 0) {
-        result = glbBuildGenerateCode_C_FuncPointersDeclGlobal(context, 0, codeOut);
-    }
-    if (strcmp(tag, "/*<<opengl_funcpointers_decl_global:4>>*/") == 0) {
-        result = glbBuildGenerateCode_C_FuncPointersDeclGlobal(context, 4, codeOut);
-    }
-    if (strcmp(tag, "/*<<init_current_context_api>>*/") == 0) {
-        result = glbBuildGenerateCode_C_InitCurrentContextAPI(context, codeOut);
-    }
-    if (strcmp(tag, "/*<<set_global_api_from_struct>>*/") == 0) {
-        result = glbBuildGenerateCode_C_SetGlobalAPIFromStruct(context, codeOut);
-    }
-    if (strcmp(tag, "<<opengl_version>>") == 0) {
-        result = vkbBuildGenerateCode_C_OpenGLVersion(context, codeOut);
+    // With a single variant everything is timed together. With several, the phases for each variant are timed separately since they
+    // run in parallel.
+    glbBuildStats* pStats = outputStats ? &stats : NULL;
+    for (size_t iVariant = 0; iVariant < variants.size(); ++iVariant) {
+        if (outputStats) {
+            variants[iVariant].generateOptions.pStats = (variants.size() == 1) ? &stats : &variants[iVariant].stats;
+        }
     }
-    if (strcmp(tag, "<<revision>>") == 0) {
-        result = glbBuildGenerateCode_C_Revision(context, codeOut);
+
+    // GL, WGL and GLX. These are loaded in parallel.
+    std::string xmlFilePathStrings[3] = {
+        registryDirectory + "/gl.xml",
+        registryDirectory + "/wgl.xml",
+        registryDirectory + "/glx.xml"
+    };
+
+    const char* xmlFilePaths[3] = {
+        xmlFilePathStrings[0].c_str(),
+        xmlFilePathStrings[1].c_str(),
+        xmlFilePathStrings[2].c_str()
+    };
+
+    // Variants can share a template.
+    std::vector<std::string> templateFilePaths;
+    for (size_t iVariant = 0; iVariant < variants.size(); ++iVariant) {
+        const std::string &templateFilePath = variants[iVariant].generateOptions.templateFilePath;
+        if (std::find(templateFilePaths.begin(), templateFilePaths.end(), templateFilePath) == templateFilePaths.end()) {
+            templateFilePaths.push_back(templateFilePath);
+        }
     }
-    if (strcmp(tag, "<<date>>") == 0) {
-        result = glbBuildGenerateCode_C_Date(context, codeOut);
+
+    // The cache is keyed by the content of the XML files for the registry, and by everything else that can affect the output for the
+    // generated files, which is the content of the templates and the options of each variant. When there's a manifest, its variants
+    // are hashed after they've been parsed so comments and the order of options in it don't matter.
+    if (cacheFilePath.empty()) {
+        cacheFilePath = glbBuildGetDefaultCachePath(variants[0].generateOptions.outputFilePath);
     }
 
-    return result;
-}
+    uint64_t registryHash = GLB_HASH_INIT;
+    uint64_t generatorHash = GLB_HASH_INIT;
+    if (useCache) {
+        for (size_t iFile = 0; iFile < sizeof(xmlFilePaths)/sizeof(xmlFilePaths[0]); ++iFile) {
+            result = glbHashFile(registryHash, xmlFilePaths[iFile], &registryHash);
+            if (result != GLB_SUCCESS) {
+                printf("Failed to open %s\n", xmlFilePaths[iFile]);
+                return result;
+            }
+        }
 
-glbResult glbBuildGenerateOutputFile(glbBuild &context, const char* outputFilePath)
-{
-    // Before doing anything we need to grab the template.
-    size_t templateFileSize;
-    char* pTemplateFileData;
-    glbResult result = glbOpenAndReadTextFile(GLB_BUILD_TEMPLATE_PATH, &templateFileSize, &pTemplateFileData);
-    if (result != GLB_SUCCESS) {
-        return result;
+        generatorHash = glbHash(generatorHash, GLB_BUILD_ID, strlen(GLB_BUILD_ID) + 1);
+        for (size_t iVariant = 0; iVariant < variants.size(); ++iVariant) {
+            generatorHash = glbBuildHashVariant(generatorHash, variants[iVariant]);
+        }
+
+        for (size_t iTemplate = 0; iTemplate < templateFilePaths.size(); ++iTemplate) {
+            result = glbHashFile(generatorHash, templateFilePaths[iTemplate].c_str(), &generatorHash);
+            if (result != GLB_SUCCESS) {
+                printf("Failed to open %s\n", templateFilePaths[iTemplate].c_str());
+                return result;
+            }
+        }
     }
 
-    std::string outputStr = pTemplateFileData;
-    free(pTemplateFileData);
+    glbBuildStatsEndPhase(pStats, "hash inputs");
+
+    bool isRegistryLoaded = false;
+    if (useCache) {
+        glbMappedFile cacheFile;
+        glbBuildCacheHeader cacheHeader;
+        if (glbBuildOpenCache(cacheFilePath.c_str(), &cacheFile, &cacheHeader) == GLB_SUCCESS) {
+            if (cacheHeader.registryHash == registryHash) {
+                // Nothing to do if the output files are exactly what we'd generate.
+                uint64_t outputHash;
+                if (cacheHeader.generatorHash == generatorHash && glbBuildHashOutputFiles(variants, &outputHash) == GLB_SUCCESS && outputHash == cacheHeader.outputHash) {
+                    glbUnmapFile(&cacheFile);
+                    for (size_t iVariant = 0; iVariant < variants.size(); ++iVariant) {
+                        printf("%s is up to date.\n", variants[iVariant].generateOptions.outputFilePath.c_str());
+                    }
+                    return 0;
+                }
 
-    // There will be a series of tags that we need to replace with generated code.
-    const char* tags[] = {
-        "/*<<opengl_main>>*/",
-        "/*<<opengl_funcpointers_decl_global>>*/",
-        "/*<<opengl_funcpointers_decl_global:4>>*/",
-        "/*<<init_current_context_api>>*/",
-        "/*<<set_global_api_from_struct>>*/",
-        "<<opengl_version>>",
-        "<<revision>>",
-        "<<date>>",
-    };
+                isRegistryLoaded = (glbBuildLoadCacheRegistry(context, cacheFile) == GLB_SUCCESS);
+            }
+
+            glbUnmapFile(&cacheFile);
+        }
+    }
 
-    for (size_t iTag = 0; iTag < sizeof(tags)/sizeof(tags[0]); ++iTag) {
-        std::string generatedCode;
-        result = glbBuildGenerateCode_C(context, tags[iTag], generatedCode);
+    if (!isRegistryLoaded) {
+        result = glbBuildLoadXMLFiles(context, xmlFilePaths, sizeof(xmlFilePaths)/sizeof(xmlFilePaths[0]), useDOM);
         if (result != GLB_SUCCESS) {
             return result;
         }
-
-        glbReplaceAllInline(outputStr, tags[iTag], generatedCode);
     }
 
-    glbOpenAndWriteTextFile(outputFilePath, outputStr.c_str());
-    return GLB_SUCCESS;
-}
+    glbBuildStatsEndPhase(pStats, isRegistryLoaded ? "load registry from cache" : "load registry from XML");
 
+    if (verifyParser) {
+        glbBuild reference;
+        result = glbBuildLoadXMLFiles(reference, xmlFilePaths, sizeof(xmlFilePaths)/sizeof(xmlFilePaths[0]), !useDOM);
+        if (result != GLB_SUCCESS) {
+            return result;
+        }
 
-int main(int argc, char** argv)
-{
-    glbBuild context;
-    glbResult result;
+        if (!glbBuildCompareRegistries(reference, context)) {
+            return GLB_ERROR;
+        }
 
-    // GL
-    result = glbBuildLoadXMLFile(context, GLB_BUILD_XML_PATH_GL);
-    if (result != GLB_SUCCESS) {
-        return result;
-    }
-    
-    // WGL
-    result = glbBuildLoadXMLFile(context, GLB_BUILD_XML_PATH_WGL);
-    if (result != GLB_SUCCESS) {
-        return result;
+        printf("Pull parser and DOM loader produced identical registries.\n");
+        return 0;
     }
 
-    // GLX
-    result = glbBuildLoadXMLFile(context, GLB_BUILD_XML_PATH_GLX);
-    if (result != GLB_SUCCESS) {
-        return result;
+    // The cache holds the whole registry so it needs to be serialized before it's trimmed down to the selection.
+    std::string cacheData;
+    if (useCache) {
+        glbBuildSerializeRegistry(context, cacheData);
+        glbBuildStatsEndPhase(pStats, "serialize cache");
     }
 
 
@@ -1765,16 +5069,107 @@ int main(int argc, char** argv)
     }
 #endif
 
+    // Output files. In deterministic mode every variant gets the same date, and a revision derived from the content of the registry and
+    // its template, its selection and whether or not the implementation is split out. File paths are left out so the output doesn't
+    // depend on where it's generated.
+    if (defaults.generateOptions.deterministic) {
+        std::string date = glbBuildGetDeterministicDate();
+
+        uint64_t xmlHash = GLB_HASH_INIT;
+        for (size_t iFile = 0; iFile < sizeof(xmlFilePaths)/sizeof(xmlFilePaths[0]); ++iFile) {
+            result = glbHashFile(xmlHash, xmlFilePaths[iFile], &xmlHash);
+            if (result != GLB_SUCCESS) {
+                printf("Failed to open %s\n", xmlFilePaths[iFile]);
+                return result;
+            }
+        }
+
+        for (size_t iVariant = 0; iVariant < variants.size(); ++iVariant) {
+            glbBuildGenerateOptions &options = variants[iVariant].generateOptions;
+
+            uint64_t inputHash;
+            result = glbHashFile(xmlHash, options.templateFilePath.c_str(), &inputHash);
+            if (result != GLB_SUCCESS) {
+                printf("Failed to open %s\n", options.templateFilePath.c_str());
+                return result;
+            }
+
+            bool isSplit = !options.sourceFilePath.empty();
+            inputHash = glbBuildHashSelection(inputHash, variants[iVariant].selection);
+            inputHash = glbHash(inputHash, &isSplit, sizeof(isSplit));
+
+            options.revision = glbBuildGetDeterministicRevision(inputHash);
+            options.date     = date;
+        }
+    }
+
+    // Each variant trims the registry down to its own selection so, when there's more than one, each gets its own copy of the registry
+    // that was loaded above. Variants don't share any state so they're generated in parallel.
+    std::vector<glbBuild> variantContexts(variants.size() > 1 ? variants.size() : 0);
+    if (variants.size() == 1) {
+        result = glbBuildGenerateVariant(context, variants[0]);
+    } else {
+        std::vector<glbResult> results(variants.size(), GLB_SUCCESS);
+        std::vector<std::thread> threads;
+        for (size_t iVariant = 0; iVariant < variants.size(); ++iVariant) {
+            threads.emplace_back([&, iVariant]() {
+                glbBuildStats* pVariantStats = variants[iVariant].generateOptions.pStats;
+                if (pVariantStats != NULL) {
+                    pVariantStats->start = pVariantStats->phaseStart = std::chrono::steady_clock::now();
+                }
+
+                variantContexts[iVariant] = context;
+                glbBuildStatsEndPhase(pVariantStats, "copy registry");
+
+                results[iVariant] = glbBuildGenerateVariant(variantContexts[iVariant], variants[iVariant]);
+            });
+        }
+
+        for (size_t iThread = 0; iThread < threads.size(); ++iThread) {
+            threads[iThread].join();
+        }
+
+        glbBuildStatsEndPhase(pStats, "generate variants");
+
+        for (size_t iVariant = 0; iVariant < variants.size(); ++iVariant) {
+            if (results[iVariant] != GLB_SUCCESS) {
+                result = results[iVariant];
+            }
+        }
+    }
 
-    // Output file.
-    result = glbBuildGenerateOutputFile(context, "../../glbind.h");
     if (result != GLB_SUCCESS) {
-        printf("Failed to generate output file.\n");
         return (int)result;
     }
 
+    // The cache is updated even when the registry came from it so the hash of the new output files is recorded. Failing to write the
+    // cache is not an error.
+    if (useCache) {
+        glbBuildCacheHeader cacheHeader;
+        cacheHeader.magic         = GLB_BUILD_CACHE_MAGIC;
+        cacheHeader.version       = GLB_BUILD_CACHE_VERSION;
+        cacheHeader.registryHash  = registryHash;
+        cacheHeader.generatorHash = generatorHash;
+
+        if (glbBuildHashOutputFiles(variants, &cacheHeader.outputHash) != GLB_SUCCESS || glbBuildSaveCache(cacheData, cacheHeader, cacheFilePath.c_str()) != GLB_SUCCESS) {
+            printf("Failed to write %s\n", cacheFilePath.c_str());
+        }
+
+        glbBuildStatsEndPhase(pStats, "save cache");
+    }
+
+    if (outputStats) {
+        if (variants.size() == 1) {
+            glbBuildPrintStats(context, stats);
+        } else {
+            glbBuildPrintStatsPhases(stats);
+            for (size_t iVariant = 0; iVariant < variants.size(); ++iVariant) {
+                printf("\n%s\n", variants[iVariant].generateOptions.outputFilePath.c_str());
+                glbBuildPrintStats(variantContexts[iVariant], variants[iVariant].stats);
+            }
+        }
+    }
+
     // Getting here means we're done.
-    (void)argc;
-    (void)argv;
     return 0;
-}
\ No newline at end of file
+}
@@ -120,23 +120,62 @@ some program wants to use them.
 
 /*<<opengl_main>>*/
 
+typedef void (* GLBproc)(void);
+
+/*
+When the implementation is compiled into a shared library, each global function pointer is exported and needs a GLOB_DAT relocation for
+glbBindAPI() to reach it. GLBIND_HIDE_GLOBAL_COMMANDS gives them hidden visibility instead, so they're only visible to the library that
+contains the implementation and cost nothing at load time. Data isn't exported from a DLL unless it's marked, so Windows is unaffected.
+*/
+#if defined(GLBIND_HIDE_GLOBAL_COMMANDS) && defined(__GNUC__) && !defined(_WIN32)
+#pragma GCC visibility push(hidden)
+#endif
 /*<<opengl_funcpointers_decl_global>>*/
+#if defined(GLBIND_HIDE_GLOBAL_COMMANDS) && defined(__GNUC__) && !defined(_WIN32)
+#pragma GCC visibility pop
+#endif
 
 typedef struct
 {
 /*<<opengl_funcpointers_decl_global:4>>*/
 } GLBapi;
 
+/*
+The limits of a context, such as GL_MAX_TEXTURE_SIZE, as retrieved by glbQueryLimits(). The members are named after the enum, so
+GL_MAX_TEXTURE_SIZE is maxTextureSize. Limits are only members when the version of OpenGL that added them has been included.
+*/
+typedef struct
+{
+    GLint majorVersion;     /* The version of the context the limits were retrieved from. */
+    GLint minorVersion;
+/*<<limits>>*/
+} GLBlimits;
+
 typedef struct
 {
     GLboolean singleBuffered;
+    GLuint resolveThreadCount;  /* The number of threads to retrieve function pointers with. 0 or 1 retrieves them on the calling thread. GLX only. */
 #if defined(GLBIND_WGL)
 #endif
 #if defined(GLBIND_GLX)
-    Display* pDisplay;
+    Display* pDisplay;              /* The display to create the internal rendering context on. NULL to open a new connection. */
+    const char* pResolveCachePath;  /* A file for caching function pointers between runs. NULL to disable. Must remain valid until glbUninit(). */
+    GLboolean noGLVND;              /* Load libGL.so.1 even when libOpenGL.so.0 and libGLX.so.0 are available. */
 #endif
 } GLBconfig;
 
+/*
+Statistics about the creation of the internal rendering context, as retrieved by glbGetInitStats(). Always 0 with WGL.
+
+These are worked out from the sequence numbers Xlib keeps for the display. A call that waited for several replies is only counted as
+one round trip, and requests a driver sends through XCB rather than Xlib may not be counted at all.
+*/
+typedef struct
+{
+    GLuint xRequestCount;   /* The number of requests sent to the X server, not including those sent while opening the display. */
+    GLuint xRoundTripCount; /* The number of calls that waited for a reply from the X server, including opening the display. */
+} GLBinitStats;
+
 /*
 Initializes a config object which can later be passed to glbInit() to configure the rendering context that's created by glbInit().
 */
@@ -164,6 +203,40 @@ defaults. Initialize the config object with glbConfigInit(). The default config
 */
 GLenum glbInit(GLBapi* pAPI, GLBconfig* pConfig);
 
+/*
+Starts initializing glbind on a background thread and returns straight away.
+
+This does the same as glbInit(), including loading the OpenGL libraries, creating the internal rendering context and retrieving
+function pointers, but the caller can get on with other work, such as loading assets, in the meantime. Use glbInitWait() to wait for
+initialization to finish and to retrieve the result. No other glbind APIs can be called until glbInitWait() has returned. The config
+is copied so pConfig does not need to remain valid.
+
+If glbind is already initialized, or the thread can't be created, initialization is done on the calling thread before returning. In
+either case glbInitWait() must still be called. Each successful initialization must be matched with a call to glbUninit(). Returns
+GL_INVALID_OPERATION if a previous call has not yet been waited on.
+
+If the config has a display, the background thread uses it. The application must not use it until glbInitWait() has returned unless
+XInitThreads() has been called.
+*/
+GLenum glbInitAsync(GLBconfig* pConfig);
+
+/*
+Waits for initialization started with glbInitAsync() to finish.
+
+The return value is the same as would have been returned by glbInit(). On success the internal rendering context is made current
+on the calling thread, and the function pointers are bound to global scope if this was the first initialization, just like glbInit().
+pAPI is optional. On output it will contain pointers to all OpenGL APIs found by the loader. Returns GL_INVALID_OPERATION if
+glbInitAsync() has not been called.
+*/
+GLenum glbInitWait(GLBapi* pAPI);
+
+/*
+Retrieves statistics about the creation of the internal rendering context by the first call to glbInit().
+
+This is intended for measuring how long initialization is going to take over a slow connection to the X server.
+*/
+GLBinitStats glbGetInitStats();
+
 /*
 Loads context-specific APIs into the specified API object.
 
@@ -195,6 +268,26 @@ Binds the function pointers in pAPI to global scope.
 */
 GLenum glbBindAPI(const GLBapi* pAPI);
 
+/*
+Retrieves a function pointer from an API object by name.
+
+This only looks at pAPI and never calls into the driver which makes it suitable for looking up commands by name at run time. The lookup
+is a hash and a string comparison. Returns NULL if the name is not a command known to glbind, if the command has been excluded at compile
+time, or if it was not found when pAPI was initialized.
+*/
+GLBproc glbGetProcFromAPI(const GLBapi* pAPI, const char* name);
+
+/*
+Retrieves the limits of the current context.
+
+pAPI is optional. If non-null, the APIs from this object will be used. Otherwise, whatever is bound to global scope will be used.
+
+This is intended to be called once after making a context current, after which limits can be read from pLimits instead of calling
+glGetIntegerv() each time. Limits that aren't supported by the version of the context, and limits that have been removed from the core
+profile when the context is using it, are set to 0. Returns GL_INVALID_OPERATION if there is no current context.
+*/
+GLenum glbQueryLimits(const GLBapi* pAPI, GLBlimits* pLimits);
+
 /* Platform-specific APIs. */
 #if defined(GLBIND_WGL)
 /*
@@ -226,12 +319,19 @@ Retrieves the rendering context that was created on the first call to glbInit().
 GLXContext glbGetRC();
 
 /*
-Retrieves the color map that was created on the first call to glbInit().
+Retrieves the framebuffer config that was chosen on the first call to glbInit(). Windows and pbuffers created with this config can be
+used with the internal rendering context.
+*/
+GLXFBConfig glbGetFBConfig();
+
+/*
+Retrieves a color map for the framebuffer visual. The internal rendering context doesn't need one, so it's created the first time this
+is called.
 */
 Colormap glbGetColormap();
 
 /*
-Retrieves the framebuffer visual info that was created on the first call to glbInit().
+Retrieves the visual info of the framebuffer config that was chosen on the first call to glbInit().
 */
 XVisualInfo* glbGetFBVisualInfo();
 #endif
@@ -266,10 +366,12 @@ GLboolean glbIsExtensionSupported(GLBapi* pAPI, const char* extensionName);
 #if defined(GLBIND_GLX)
     #include <unistd.h>
     #include <dlfcn.h>
+    #include <pthread.h>    /* For glbInitAsync(). */
+    #include <stdio.h>      /* For the resolution cache. */
+    #include <sys/stat.h>
 #endif
 
 typedef void* GLBhandle;
-typedef void (* GLBproc)(void);
 
 void glbZeroMemory(void* p, size_t sz)
 {
@@ -281,6 +383,51 @@ void glbZeroMemory(void* p, size_t sz)
 
 #define glbZeroObject(p) glbZeroMemory((p), sizeof(*(p)));
 
+void glbCopyMemory(void* pDst, const void* pSrc, size_t sz)
+{
+    size_t i;
+    for (i = 0; i < sz; ++i) {
+        ((GLbyte*)pDst)[i] = ((const GLbyte*)pSrc)[i];
+    }
+}
+
+int glbCompareMemory(const void* p1, const void* p2, size_t sz)
+{
+    size_t i;
+    for (i = 0; i < sz; ++i) {
+        if (((const unsigned char*)p1)[i] != ((const unsigned char*)p2)[i]) {
+            return ((const unsigned char*)p1)[i] - ((const unsigned char*)p2)[i];
+        }
+    }
+
+    return 0;
+}
+
+int glb_strcmp(const char* s1, const char* s2)
+{
+    while ((*s1) && (*s1 == *s2)) {
+        ++s1;
+        ++s2;
+    }
+
+    return (*(unsigned char*)s1 - *(unsigned char*)s2);
+}
+
+int glb_strncmp(const char* s1, const char* s2, size_t n)
+{
+    while (n && *s1 && (*s1 == *s2)) {
+        ++s1;
+        ++s2;
+        --n;
+    }
+
+    if (n == 0) {
+        return 0;
+    } else {
+        return (*(unsigned char*)s1 - *(unsigned char*)s2);
+    }
+}
+
 GLBhandle glb_dlopen(const char* filename)
 {
 #ifdef _WIN32
@@ -290,6 +437,23 @@ GLBhandle glb_dlopen(const char* filename)
 #endif
 }
 
+/* Returns a handle to a library only if it's already been loaded into the process. The reference count is incremented like glb_dlopen(). */
+GLBhandle glb_dlopen_existing(const char* filename)
+{
+#ifdef _WIN32
+    HMODULE hModule;
+    if (!GetModuleHandleExA(0, filename, &hModule)) {
+        return NULL;
+    }
+    return (GLBhandle)hModule;
+#elif defined(RTLD_NOLOAD)
+    return (GLBhandle)dlopen(filename, RTLD_NOW | RTLD_NOLOAD);
+#else
+    (void)filename;
+    return NULL;
+#endif
+}
+
 void glb_dlclose(GLBhandle handle)
 {
 #ifdef _WIN32
@@ -318,6 +482,27 @@ GLBproc glb_dlsym(GLBhandle handle, const char* symbol)
 
 static unsigned int g_glbInitCount = 0;
 static GLBhandle g_glbOpenGLSO = NULL;
+static GLBinitStats g_glbInitStats;
+static GLuint g_glbResolveThreadCount = 0;
+#if defined(GLBIND_GLX)
+static const char* g_glbResolveCachePath = NULL;
+static GLboolean g_glbNoGLVND = GL_FALSE;
+#endif
+
+/* State for glbInitAsync(). The API object is filled on the background thread and copied out by glbInitWait(). */
+static GLboolean g_glbAsyncPending   = GL_FALSE;
+static GLboolean g_glbAsyncThreaded  = GL_FALSE;
+static GLboolean g_glbAsyncHasConfig = GL_FALSE;
+static GLBconfig g_glbAsyncConfig;
+static GLBapi    g_glbAsyncAPI;
+static GLenum    g_glbAsyncResult;
+#if defined(GLBIND_WGL)
+static HANDLE    g_glbAsyncThread;
+static HWND      g_glbAsyncDummyHWND;
+#endif
+#if defined(GLBIND_GLX)
+static pthread_t g_glbAsyncThread;
+#endif
 
 #if defined(GLBIND_WGL)
 HWND  glbind_DummyHWND = 0;
@@ -330,11 +515,29 @@ static LRESULT GLBIND_DummyWindowProcWin32(HWND hWnd, UINT msg, WPARAM wParam, L
 {
     return DefWindowProc(hWnd, msg, wParam, lParam);
 }
+
+static HWND glbCreateDummyWindowWin32()
+{
+    WNDCLASSEXW dummyWC;
+    memset(&dummyWC, 0, sizeof(dummyWC));
+    dummyWC.cbSize        = sizeof(dummyWC);
+    dummyWC.lpfnWndProc   = (WNDPROC)GLBIND_DummyWindowProcWin32;
+    dummyWC.lpszClassName = L"GLBIND_DummyHWND";
+    dummyWC.style         = CS_OWNDC;
+    if (!RegisterClassExW(&dummyWC)) {
+        return 0;
+    }
+
+    return CreateWindowExW(0, L"GLBIND_DummyHWND", L"", 0, 0, 0, 0, 0, NULL, NULL, GetModuleHandle(NULL), NULL);
+}
 #endif
 #if defined(GLBIND_GLX)
 Display*     glbind_pDisplay      = 0;
 Window       glbind_DummyWindow   = 0;
+GLXPbuffer   glbind_DummyPbuffer  = 0;
+GLXDrawable  glbind_DummyDrawable = 0;  /* Either glbind_DummyPbuffer or glbind_DummyWindow. */
 GLXContext   glbind_RC            = 0;
+GLXFBConfig  glbind_FBConfig      = 0;
 Colormap     glbind_Colormap      = 0;
 XVisualInfo* glbind_pFBVisualInfo = 0;
 GLboolean    glbind_OwnsDisplay   = GL_FALSE;
@@ -351,6 +554,7 @@ PFNWGLMAKECURRENTPROC           glbind_wglMakeCurrent;
 #if defined(GLBIND_GLX)
 PFNGLXCHOOSEVISUALPROC          glbind_glXChooseVisual;
 PFNGLXCREATECONTEXTPROC         glbind_glXCreateContext;
+PFNGLXCREATENEWCONTEXTPROC      glbind_glXCreateNewContext;
 PFNGLXDESTROYCONTEXTPROC        glbind_glXDestroyContext;
 PFNGLXMAKECURRENTPROC           glbind_glXMakeCurrent;
 PFNGLXSWAPBUFFERSPROC           glbind_glXSwapBuffers;
@@ -360,8 +564,11 @@ PFNGLXGETCURRENTDISPLAYPROC     glbind_glXGetCurrentDisplay;
 PFNGLXGETCURRENTDRAWABLEPROC    glbind_glXGetCurrentDrawable;
 PFNGLXCHOOSEFBCONFIGPROC        glbind_glXChooseFBConfig;
 PFNGLXGETVISUALFROMFBCONFIGPROC glbind_glXGetVisualFromFBConfig;
+PFNGLXCREATEPBUFFERPROC         glbind_glXCreatePbuffer;
+PFNGLXDESTROYPBUFFERPROC        glbind_glXDestroyPbuffer;
 PFNGLXGETPROCADDRESSPROC        glbind_glXGetProcAddress;
 
+static GLBhandle g_glbGLXSO = NULL;   /* The same as g_glbOpenGLSO unless libGLX.so.0 has been loaded. */
 static GLBhandle g_glbX11SO = NULL;
 typedef Display* (* GLB_PFNXOPENDISPLAYPROC)   (char* pDisplayName);
 typedef int      (* GLB_PFNXCLOSEDISPLAYPROC)  (Display* pDisplay);
@@ -370,6 +577,7 @@ typedef int      (* GLB_PFNXDESTROYWINDOWPROC) (Display* pDisplay, Window window
 typedef Colormap (* GLB_PFNXCREATECOLORMAPPROC)(Display *pDisplay, Window window, Visual* pVisual, int alloc);
 typedef int      (* GLB_PFNXFREECOLORMAPPROC)  (Display *pDisplay, Colormap colormap);
 typedef int      (* GLB_PFNXDEFAULTSCREENPROC) (Display* pDisplay);
+typedef int      (* GLB_PFNXFREEPROC)          (void* pData);
 
 GLB_PFNXOPENDISPLAYPROC    glbind_XOpenDisplay;
 GLB_PFNXCLOSEDISPLAYPROC   glbind_XCloseDisplay;
@@ -378,6 +586,7 @@ GLB_PFNXDESTROYWINDOWPROC  glbind_XDestroyWindow;
 GLB_PFNXCREATECOLORMAPPROC glbind_XCreateColormap;
 GLB_PFNXFREECOLORMAPPROC   glbind_XFreeColormap;
 GLB_PFNXDEFAULTSCREENPROC  glbind_XDefaultScreen;
+GLB_PFNXFREEPROC           glbind_XFree;
 #endif
 
 GLBproc glbGetProcAddress(const char* name)
@@ -401,10 +610,32 @@ GLBproc glbGetProcAddress(const char* name)
     return func;
 }
 
+void glbUnloadOpenGLSO()
+{
+#if defined(GLBIND_GLX)
+    if (g_glbX11SO != NULL) {
+        glb_dlclose(g_glbX11SO);
+        g_glbX11SO = NULL;
+    }
+
+    if (g_glbGLXSO != NULL && g_glbGLXSO != g_glbOpenGLSO) {
+        glb_dlclose(g_glbGLXSO);
+    }
+    g_glbGLXSO = NULL;
+#endif
+
+    if (g_glbOpenGLSO != NULL) {
+        glb_dlclose(g_glbOpenGLSO);
+        g_glbOpenGLSO = NULL;
+    }
+}
+
 GLenum glbLoadOpenGLSO()
 {
     GLenum result;
     size_t i;
+    int iPass;
+    GLBhandle (* openProc)(const char* filename);
 
     const char* openGLSONames[] = {
 #if defined(_WIN32)
@@ -417,12 +648,46 @@ GLenum glbLoadOpenGLSO()
     };
 
     result = GL_INVALID_OPERATION;
-    for (i = 0; i < sizeof(openGLSONames)/sizeof(openGLSONames[0]); ++i) {
-        GLBhandle handle = glb_dlopen(openGLSONames[i]);
-        if (handle != NULL) {
-            g_glbOpenGLSO = handle;
-            result = GL_NO_ERROR;
-            break;
+
+    /*
+    The first pass only looks at libraries the application has already loaded. Reusing these doesn't map anything new into the process,
+    and it means glbind uses the same libraries as the application rather than loading a second set alongside them.
+    */
+    for (iPass = 0; iPass < 2 && result != GL_NO_ERROR; ++iPass) {
+        openProc = (iPass == 0) ? glb_dlopen_existing : glb_dlopen;
+
+#if defined(GLBIND_GLX)
+        /*
+        With glvnd, libGL.so.1 is a compatibility library which forwards GL to libOpenGL.so.0 and GLX to libGLX.so.0. When both of these are
+        available they're loaded directly instead, which saves loading libGL.so.1 and going through its forwarding functions.
+        */
+        if (!g_glbNoGLVND) {
+            GLBhandle openGLHandle = openProc("libOpenGL.so.0");
+            GLBhandle glxHandle    = openProc("libGLX.so.0");
+            if (openGLHandle != NULL && glxHandle != NULL) {
+                g_glbOpenGLSO = openGLHandle;
+                g_glbGLXSO    = glxHandle;
+                result = GL_NO_ERROR;
+            } else {
+                if (openGLHandle != NULL) {
+                    glb_dlclose(openGLHandle);
+                }
+                if (glxHandle != NULL) {
+                    glb_dlclose(glxHandle);
+                }
+            }
+        }
+#endif
+
+        for (i = 0; result != GL_NO_ERROR && i < sizeof(openGLSONames)/sizeof(openGLSONames[0]); ++i) {
+            GLBhandle handle = openProc(openGLSONames[i]);
+            if (handle != NULL) {
+                g_glbOpenGLSO = handle;
+#if defined(GLBIND_GLX)
+                g_glbGLXSO    = handle;     /* libGL.so.1 has both the GL and GLX APIs. */
+#endif
+                result = GL_NO_ERROR;
+            }
         }
     }
 
@@ -439,25 +704,27 @@ GLenum glbLoadOpenGLSO()
     #else
         /* X11 */
         const char* x11SONames[] = {
-            "libX11.so",
-            "libX11.so.6"
+            "libX11.so.6",
+            "libX11.so"
         };
 
         result = GL_INVALID_OPERATION;
-        for (i = 0; i < sizeof(openGLSONames)/sizeof(openGLSONames[0]); ++i) {
-            GLBhandle handle = glb_dlopen(x11SONames[i]);
-            if (handle != NULL) {
-                g_glbX11SO = handle;
-                result = GL_NO_ERROR;
-                break;
+        for (iPass = 0; iPass < 2 && result != GL_NO_ERROR; ++iPass) {
+            openProc = (iPass == 0) ? glb_dlopen_existing : glb_dlopen;
+
+            for (i = 0; result != GL_NO_ERROR && i < sizeof(x11SONames)/sizeof(x11SONames[0]); ++i) {
+                GLBhandle handle = openProc(x11SONames[i]);
+                if (handle != NULL) {
+                    g_glbX11SO = handle;
+                    result = GL_NO_ERROR;
+                }
             }
         }
     #endif
     }
 
     if (result != GL_NO_ERROR) {
-        glb_dlclose(g_glbOpenGLSO);
-        g_glbOpenGLSO = NULL;
+        glbUnloadOpenGLSO();
     }
 
     return result;
@@ -471,11 +738,73 @@ GLBconfig glbConfigInit()
     return config;
 }
 
+#if defined(GLBIND_GLX)
+/*
+These go around each call glbInit() makes to the X server to fill g_glbInitStats. A call is counted as a round trip when it sent at least
+one request and didn't return until the server had replied to the last of them.
+*/
+static unsigned long g_glbXCallFirstRequest;
+
+static void glbBeginXCall()
+{
+    g_glbXCallFirstRequest = NextRequest(glbind_pDisplay);
+}
+
+static void glbEndXCall()
+{
+    unsigned long nextRequest = NextRequest(glbind_pDisplay);
+    if (nextRequest != g_glbXCallFirstRequest) {
+        g_glbInitStats.xRequestCount += (GLuint)(nextRequest - g_glbXCallFirstRequest);
+        if (LastKnownRequestProcessed(glbind_pDisplay) == nextRequest - 1) {
+            g_glbInitStats.xRoundTripCount += 1;
+        }
+    }
+}
+
+static void glbDeleteDummyObjectsGLX()
+{
+    if (glbind_RC) {
+        glbind_glXDestroyContext(glbind_pDisplay, glbind_RC);
+        glbind_RC = 0;
+    }
+    if (glbind_DummyPbuffer) {
+        glbind_glXDestroyPbuffer(glbind_pDisplay, glbind_DummyPbuffer);
+        glbind_DummyPbuffer = 0;
+    }
+    if (glbind_DummyWindow) {
+        glbind_XDestroyWindow(glbind_pDisplay, glbind_DummyWindow);
+        glbind_DummyWindow = 0;
+    }
+    if (glbind_Colormap) {
+        glbind_XFreeColormap(glbind_pDisplay, glbind_Colormap);
+        glbind_Colormap = 0;
+    }
+    if (glbind_pFBVisualInfo) {
+        glbind_XFree(glbind_pFBVisualInfo);
+        glbind_pFBVisualInfo = 0;
+    }
+    if (glbind_pDisplay && glbind_OwnsDisplay) {
+        glbind_XCloseDisplay(glbind_pDisplay);
+    }
+
+    glbind_DummyDrawable = 0;
+    glbind_FBConfig      = 0;
+    glbind_pDisplay      = 0;
+    glbind_OwnsDisplay   = GL_FALSE;
+}
+#endif
+
 GLenum glbInit(GLBapi* pAPI, GLBconfig* pConfig)
 {
     GLenum result;
 
     if (g_glbInitCount == 0) {
+        g_glbResolveThreadCount = (pConfig != NULL) ? pConfig->resolveThreadCount : 0;
+#if defined(GLBIND_GLX)
+        g_glbResolveCachePath   = (pConfig != NULL) ? pConfig->pResolveCachePath  : NULL;
+        g_glbNoGLVND            = (pConfig != NULL) ? pConfig->noGLVND            : GL_FALSE;
+#endif
+
         result = glbLoadOpenGLSO();
         if (result != GL_NO_ERROR) {
             return result;
@@ -496,27 +825,30 @@ GLenum glbInit(GLBapi* pAPI, GLBconfig* pConfig)
             glbind_wglGetCurrentDC      == NULL ||
             glbind_wglGetProcAddress    == NULL ||
             glbind_wglMakeCurrent       == NULL) {
-            glb_dlclose(g_glbOpenGLSO);
-            g_glbOpenGLSO = NULL;
+            glbUnloadOpenGLSO();
             return GL_INVALID_OPERATION;
         }
 #endif
 #if defined(GLBIND_GLX)
-        glbind_glXChooseVisual          = (PFNGLXCHOOSEVISUALPROC         )glb_dlsym(g_glbOpenGLSO, "glXChooseVisual");
-        glbind_glXCreateContext         = (PFNGLXCREATECONTEXTPROC        )glb_dlsym(g_glbOpenGLSO, "glXCreateContext");
-        glbind_glXDestroyContext        = (PFNGLXDESTROYCONTEXTPROC       )glb_dlsym(g_glbOpenGLSO, "glXDestroyContext");
-        glbind_glXMakeCurrent           = (PFNGLXMAKECURRENTPROC          )glb_dlsym(g_glbOpenGLSO, "glXMakeCurrent");
-        glbind_glXSwapBuffers           = (PFNGLXSWAPBUFFERSPROC          )glb_dlsym(g_glbOpenGLSO, "glXSwapBuffers");
-        glbind_glXGetCurrentContext     = (PFNGLXGETCURRENTCONTEXTPROC    )glb_dlsym(g_glbOpenGLSO, "glXGetCurrentContext");
-        glbind_glXQueryExtensionsString = (PFNGLXQUERYEXTENSIONSSTRINGPROC)glb_dlsym(g_glbOpenGLSO, "glXQueryExtensionsString");
-        glbind_glXGetCurrentDisplay     = (PFNGLXGETCURRENTDISPLAYPROC    )glb_dlsym(g_glbOpenGLSO, "glXGetCurrentDisplay");
-        glbind_glXGetCurrentDrawable    = (PFNGLXGETCURRENTDRAWABLEPROC   )glb_dlsym(g_glbOpenGLSO, "glXGetCurrentDrawable");
-        glbind_glXChooseFBConfig        = (PFNGLXCHOOSEFBCONFIGPROC       )glb_dlsym(g_glbOpenGLSO, "glXChooseFBConfig");
-        glbind_glXGetVisualFromFBConfig = (PFNGLXGETVISUALFROMFBCONFIGPROC)glb_dlsym(g_glbOpenGLSO, "glXGetVisualFromFBConfig");
-        glbind_glXGetProcAddress        = (PFNGLXGETPROCADDRESSPROC       )glb_dlsym(g_glbOpenGLSO, "glXGetProcAddress");
+        glbind_glXChooseVisual          = (PFNGLXCHOOSEVISUALPROC         )glb_dlsym(g_glbGLXSO, "glXChooseVisual");
+        glbind_glXCreateContext         = (PFNGLXCREATECONTEXTPROC        )glb_dlsym(g_glbGLXSO, "glXCreateContext");
+        glbind_glXCreateNewContext      = (PFNGLXCREATENEWCONTEXTPROC     )glb_dlsym(g_glbGLXSO, "glXCreateNewContext");
+        glbind_glXDestroyContext        = (PFNGLXDESTROYCONTEXTPROC       )glb_dlsym(g_glbGLXSO, "glXDestroyContext");
+        glbind_glXMakeCurrent           = (PFNGLXMAKECURRENTPROC          )glb_dlsym(g_glbGLXSO, "glXMakeCurrent");
+        glbind_glXSwapBuffers           = (PFNGLXSWAPBUFFERSPROC          )glb_dlsym(g_glbGLXSO, "glXSwapBuffers");
+        glbind_glXGetCurrentContext     = (PFNGLXGETCURRENTCONTEXTPROC    )glb_dlsym(g_glbGLXSO, "glXGetCurrentContext");
+        glbind_glXQueryExtensionsString = (PFNGLXQUERYEXTENSIONSSTRINGPROC)glb_dlsym(g_glbGLXSO, "glXQueryExtensionsString");
+        glbind_glXGetCurrentDisplay     = (PFNGLXGETCURRENTDISPLAYPROC    )glb_dlsym(g_glbGLXSO, "glXGetCurrentDisplay");
+        glbind_glXGetCurrentDrawable    = (PFNGLXGETCURRENTDRAWABLEPROC   )glb_dlsym(g_glbGLXSO, "glXGetCurrentDrawable");
+        glbind_glXChooseFBConfig        = (PFNGLXCHOOSEFBCONFIGPROC       )glb_dlsym(g_glbGLXSO, "glXChooseFBConfig");
+        glbind_glXGetVisualFromFBConfig = (PFNGLXGETVISUALFROMFBCONFIGPROC)glb_dlsym(g_glbGLXSO, "glXGetVisualFromFBConfig");
+        glbind_glXCreatePbuffer         = (PFNGLXCREATEPBUFFERPROC        )glb_dlsym(g_glbGLXSO, "glXCreatePbuffer");
+        glbind_glXDestroyPbuffer        = (PFNGLXDESTROYPBUFFERPROC       )glb_dlsym(g_glbGLXSO, "glXDestroyPbuffer");
+        glbind_glXGetProcAddress        = (PFNGLXGETPROCADDRESSPROC       )glb_dlsym(g_glbGLXSO, "glXGetProcAddress");
 
         if (glbind_glXChooseVisual          == NULL ||
             glbind_glXCreateContext         == NULL ||
+            glbind_glXCreateNewContext      == NULL ||
             glbind_glXDestroyContext        == NULL ||
             glbind_glXMakeCurrent           == NULL ||
             glbind_glXSwapBuffers           == NULL ||
@@ -526,9 +858,10 @@ GLenum glbInit(GLBapi* pAPI, GLBconfig* pConfig)
             glbind_glXGetCurrentDrawable    == NULL ||
             glbind_glXChooseFBConfig        == NULL ||
             glbind_glXGetVisualFromFBConfig == NULL ||
+            glbind_glXCreatePbuffer         == NULL ||
+            glbind_glXDestroyPbuffer        == NULL ||
             glbind_glXGetProcAddress        == NULL) {
-            glb_dlclose(g_glbOpenGLSO);
-            g_glbOpenGLSO = NULL;
+            glbUnloadOpenGLSO();
             return GL_INVALID_OPERATION;
         }
 
@@ -539,6 +872,7 @@ GLenum glbInit(GLBapi* pAPI, GLBconfig* pConfig)
         glbind_XCreateColormap = (GLB_PFNXCREATECOLORMAPPROC)glb_dlsym(g_glbX11SO, "XCreateColormap");
         glbind_XFreeColormap   = (GLB_PFNXFREECOLORMAPPROC  )glb_dlsym(g_glbX11SO, "XFreeColormap");
         glbind_XDefaultScreen  = (GLB_PFNXDEFAULTSCREENPROC )glb_dlsym(g_glbX11SO, "XDefaultScreen");
+        glbind_XFree           = (GLB_PFNXFREEPROC          )glb_dlsym(g_glbX11SO, "XFree");
 
         if (glbind_XOpenDisplay    == NULL ||
             glbind_XCloseDisplay   == NULL ||
@@ -546,137 +880,192 @@ GLenum glbInit(GLBapi* pAPI, GLBconfig* pConfig)
             glbind_XDestroyWindow  == NULL ||
             glbind_XCreateColormap == NULL ||
             glbind_XFreeColormap   == NULL ||
-            glbind_XDefaultScreen  == NULL) {
-            glb_dlclose(g_glbX11SO);
-            g_glbX11SO = NULL;
-            glb_dlclose(g_glbOpenGLSO);
-            g_glbOpenGLSO = NULL;
+            glbind_XDefaultScreen  == NULL ||
+            glbind_XFree           == NULL) {
+            glbUnloadOpenGLSO();
             return GL_INVALID_OPERATION;
         }
 #endif
-    }
 
-
-    /* Here is where we need to initialize our dummy objects so we can get a context and retrieve some API pointers. */
+        /* Here is where we need to initialize our dummy objects so we can get a context and retrieve some API pointers. */
 #if defined(GLBIND_WGL)
-    WNDCLASSEXW dummyWC;
-    memset(&dummyWC, 0, sizeof(dummyWC));
-    dummyWC.cbSize        = sizeof(dummyWC);
-    dummyWC.lpfnWndProc   = (WNDPROC)GLBIND_DummyWindowProcWin32;
-    dummyWC.lpszClassName = L"GLBIND_DummyHWND";
-    dummyWC.style         = CS_OWNDC;
-    if (!RegisterClassExW(&dummyWC)) {
-        glb_dlclose(g_glbOpenGLSO);
-        g_glbOpenGLSO = NULL;
-        return GL_INVALID_OPERATION;
-    }
+        /* When called from glbInitAsync() the window will have already been created on the thread that will be using it. */
+        if (glbind_DummyHWND == 0) {
+            glbind_DummyHWND = glbCreateDummyWindowWin32();
+            if (glbind_DummyHWND == 0) {
+                glbUnloadOpenGLSO();
+                return GL_INVALID_OPERATION;
+            }
+        }
 
-    glbind_DummyHWND = CreateWindowExW(0, L"GLBIND_DummyHWND", L"", 0, 0, 0, 0, 0, NULL, NULL, GetModuleHandle(NULL), NULL);
-    glbind_DC   = GetDC(glbind_DummyHWND);
-
-    memset(&glbind_PFD, 0, sizeof(glbind_PFD));
-    glbind_PFD.nSize        = sizeof(glbind_PFD);
-    glbind_PFD.nVersion     = 1;
-    glbind_PFD.dwFlags      = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | ((pConfig == NULL || pConfig->singleBuffered == GL_FALSE) ? PFD_DOUBLEBUFFER : 0);
-    glbind_PFD.iPixelType   = PFD_TYPE_RGBA;
-    glbind_PFD.cStencilBits = 8;
-    glbind_PFD.cDepthBits   = 24;
-    glbind_PFD.cColorBits   = 32;
-    glbind_PixelFormat = ChoosePixelFormat(glbind_DC, &glbind_PFD);
-    if (glbind_PixelFormat == 0) {
-        DestroyWindow(glbind_DummyHWND);
-        glb_dlclose(g_glbOpenGLSO);
-        g_glbOpenGLSO = NULL;
-        return GL_INVALID_OPERATION;
-    }
+        glbind_DC   = GetDC(glbind_DummyHWND);
+
+        memset(&glbind_PFD, 0, sizeof(glbind_PFD));
+        glbind_PFD.nSize        = sizeof(glbind_PFD);
+        glbind_PFD.nVersion     = 1;
+        glbind_PFD.dwFlags      = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | ((pConfig == NULL || pConfig->singleBuffered == GL_FALSE) ? PFD_DOUBLEBUFFER : 0);
+        glbind_PFD.iPixelType   = PFD_TYPE_RGBA;
+        glbind_PFD.cStencilBits = 8;
+        glbind_PFD.cDepthBits   = 24;
+        glbind_PFD.cColorBits   = 32;
+        glbind_PixelFormat = ChoosePixelFormat(glbind_DC, &glbind_PFD);
+        if (glbind_PixelFormat == 0) {
+            DestroyWindow(glbind_DummyHWND);
+            glbind_DummyHWND = 0;
+            glbUnloadOpenGLSO();
+            return GL_INVALID_OPERATION;
+        }
 
-    if (!SetPixelFormat(glbind_DC, glbind_PixelFormat, &glbind_PFD)) {
-        DestroyWindow(glbind_DummyHWND);
-        glb_dlclose(g_glbOpenGLSO);
-        g_glbOpenGLSO = NULL;
-        return GL_INVALID_OPERATION;
-    }
+        if (!SetPixelFormat(glbind_DC, glbind_PixelFormat, &glbind_PFD)) {
+            DestroyWindow(glbind_DummyHWND);
+            glbind_DummyHWND = 0;
+            glbUnloadOpenGLSO();
+            return GL_INVALID_OPERATION;
+        }
 
-    glbind_RC = glbind_wglCreateContext(glbind_DC);
-    if (glbind_RC == NULL) {
-        DestroyWindow(glbind_DummyHWND);
-        glb_dlclose(g_glbOpenGLSO);
-        g_glbOpenGLSO = NULL;
-        return GL_INVALID_OPERATION;
-    }
+        glbind_RC = glbind_wglCreateContext(glbind_DC);
+        if (glbind_RC == NULL) {
+            DestroyWindow(glbind_DummyHWND);
+            glbind_DummyHWND = 0;
+            glbUnloadOpenGLSO();
+            return GL_INVALID_OPERATION;
+        }
 
-    glbind_wglMakeCurrent(glbind_DC, glbind_RC);
+        glbind_wglMakeCurrent(glbind_DC, glbind_RC);
 #endif
 
 #if defined(GLBIND_GLX)
-    static int attribs[] = {
-        GLX_RGBA,
-        GLX_RED_SIZE,      8,
-        GLX_GREEN_SIZE,    8,
-        GLX_BLUE_SIZE,     8,
-        GLX_ALPHA_SIZE,    8,
-        GLX_DEPTH_SIZE,    24,
-        GLX_STENCIL_SIZE,  8,
-        GLX_DOUBLEBUFFER,
-        None, None
-    };
+        int attribs[] = {
+            GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT | GLX_PBUFFER_BIT,
+            GLX_RENDER_TYPE,   GLX_RGBA_BIT,
+            GLX_RED_SIZE,      8,
+            GLX_GREEN_SIZE,    8,
+            GLX_BLUE_SIZE,     8,
+            GLX_ALPHA_SIZE,    8,
+            GLX_DEPTH_SIZE,    24,
+            GLX_STENCIL_SIZE,  8,
+            GLX_DOUBLEBUFFER,  True,
+            None
+        };
+        int pbufferAttribs[] = {
+            GLX_PBUFFER_WIDTH,  1,
+            GLX_PBUFFER_HEIGHT, 1,
+            None
+        };
+        GLXFBConfig* pFBConfigs;
+        int fbConfigCount = 0;
 
-    if (pConfig != NULL) {
-        if (!pConfig->singleBuffered) {
-            attribs[13] = None;
+        if (pConfig != NULL) {
+            if (pConfig->singleBuffered) {
+                attribs[17] = False;
+            }
         }
-    }
+
+        g_glbInitStats.xRequestCount   = 0;
+        g_glbInitStats.xRoundTripCount = 0;
     
-    glbind_OwnsDisplay = GL_TRUE;
-    glbind_pDisplay = glbind_XOpenDisplay(NULL);
-    if (glbind_pDisplay == NULL) {
-        glb_dlclose(g_glbOpenGLSO);
-        g_glbOpenGLSO = NULL;
-        return GL_INVALID_OPERATION;
-    }
+        /* Using the application's display saves opening a second connection to the X server. */
+        if (pConfig != NULL && pConfig->pDisplay != NULL) {
+            glbind_OwnsDisplay = GL_FALSE;
+            glbind_pDisplay    = pConfig->pDisplay;
+        } else {
+            glbind_OwnsDisplay = GL_TRUE;
+            glbind_pDisplay    = glbind_XOpenDisplay(NULL);
+            if (glbind_pDisplay != NULL) {
+                g_glbInitStats.xRoundTripCount += 1;    /* Connecting waits for the server's setup reply. */
+            }
+        }
 
-    glbind_pFBVisualInfo = glbind_glXChooseVisual(glbind_pDisplay, DefaultScreen(glbind_pDisplay), attribs);
-    if (glbind_pFBVisualInfo == NULL) {
-        glb_dlclose(g_glbOpenGLSO);
-        g_glbOpenGLSO = NULL;
-        return GL_INVALID_OPERATION;
-    }
+        if (glbind_pDisplay == NULL) {
+            glbind_OwnsDisplay = GL_FALSE;
+            glbUnloadOpenGLSO();
+            return GL_INVALID_OPERATION;
+        }
 
-    glbind_Colormap = glbind_XCreateColormap(glbind_pDisplay, RootWindow(glbind_pDisplay, glbind_pFBVisualInfo->screen), glbind_pFBVisualInfo->visual, AllocNone);
+        /*
+        A pbuffer is all that's needed to make the context current. Unlike a window it doesn't need a visual or a colormap, so configs that
+        support one are preferred. The config is kept for glbGetFBConfig() so it's only chosen once. The first call to glXChooseFBConfig()
+        retrieves every config from the server, so trying again without pbuffers doesn't cost another round trip.
+        */
+        glbBeginXCall();
+        pFBConfigs = glbind_glXChooseFBConfig(glbind_pDisplay, DefaultScreen(glbind_pDisplay), attribs, &fbConfigCount);
+        if (pFBConfigs == NULL || fbConfigCount == 0) {
+            if (pFBConfigs != NULL) {
+                glbind_XFree(pFBConfigs);
+            }
 
-    glbind_RC = glbind_glXCreateContext(glbind_pDisplay, glbind_pFBVisualInfo, NULL, GL_TRUE);
-    if (glbind_RC == NULL) {
-        glb_dlclose(g_glbOpenGLSO);
-        g_glbOpenGLSO = NULL;
-        return GL_INVALID_OPERATION;
-    }
+            attribs[1] = GLX_WINDOW_BIT;
+            pFBConfigs = glbind_glXChooseFBConfig(glbind_pDisplay, DefaultScreen(glbind_pDisplay), attribs, &fbConfigCount);
+        }
+        glbEndXCall();
 
-    /* We cannot call any OpenGL APIs until a context is made current. In order to make a context current we will need a window. We just use a dummy window for this. */
-    XSetWindowAttributes wa;
-    wa.colormap = glbind_Colormap;
-    wa.border_pixel = 0;
+        if (pFBConfigs == NULL || fbConfigCount == 0) {
+            if (pFBConfigs != NULL) {
+                glbind_XFree(pFBConfigs);
+            }
 
-    /* Window's can not have dimensions of 0 in X11. We stick with dimensions of 1. */
-    glbind_DummyWindow = glbind_XCreateWindow(glbind_pDisplay, RootWindow(glbind_pDisplay, glbind_pFBVisualInfo->screen), 0, 0, 1, 1, 0, glbind_pFBVisualInfo->depth, InputOutput, glbind_pFBVisualInfo->visual, CWBorderPixel | CWColormap, &wa);
-    if (glbind_DummyWindow == 0) {
-        glb_dlclose(g_glbOpenGLSO);
-        g_glbOpenGLSO = NULL;
-        return GL_INVALID_OPERATION;
-    }
+            glbDeleteDummyObjectsGLX();
+            glbUnloadOpenGLSO();
+            return GL_INVALID_OPERATION;
+        }
 
-    glbind_glXMakeCurrent(glbind_pDisplay, glbind_DummyWindow, glbind_RC);
-#endif
+        glbind_FBConfig = pFBConfigs[0];
+        glbind_XFree(pFBConfigs);
 
+        glbBeginXCall();
+        glbind_RC = glbind_glXCreateNewContext(glbind_pDisplay, glbind_FBConfig, GLX_RGBA_TYPE, NULL, GL_TRUE);
+        glbEndXCall();
+        if (glbind_RC == NULL) {
+            glbDeleteDummyObjectsGLX();
+            glbUnloadOpenGLSO();
+            return GL_INVALID_OPERATION;
+        }
 
-    if (pAPI != NULL) {
-#if defined(GLBIND_WGL)
-        result = glbInitContextAPI(glbind_DC, glbind_RC, pAPI);
-#endif
-#if defined(GLBIND_GLX)
-        result = glbInitContextAPI(glbind_pDisplay, glbind_DummyWindow, glbind_RC, pAPI);
-#endif
-        if (result == GL_NO_ERROR) {
-            if (g_glbInitCount == 0) {
+        /* We cannot call any OpenGL APIs until a context is made current. In order to make a context current we will need a drawable. */
+        if ((attribs[1] & GLX_PBUFFER_BIT) != 0) {
+            glbBeginXCall();
+            glbind_DummyPbuffer = glbind_glXCreatePbuffer(glbind_pDisplay, glbind_FBConfig, pbufferAttribs);
+            glbEndXCall();
+
+            glbind_DummyDrawable = glbind_DummyPbuffer;
+        } else {
+            XVisualInfo* pVisualInfo = glbGetFBVisualInfo();
+            if (pVisualInfo != NULL) {
+                XSetWindowAttributes wa;
+
+                glbBeginXCall();
+                wa.colormap = glbGetColormap();
+                wa.border_pixel = 0;
+
+                /* Window's can not have dimensions of 0 in X11. We stick with dimensions of 1. */
+                glbind_DummyWindow = glbind_XCreateWindow(glbind_pDisplay, RootWindow(glbind_pDisplay, pVisualInfo->screen), 0, 0, 1, 1, 0, pVisualInfo->depth, InputOutput, pVisualInfo->visual, CWBorderPixel | CWColormap, &wa);
+                glbEndXCall();
+            }
+
+            glbind_DummyDrawable = glbind_DummyWindow;
+        }
+
+        if (glbind_DummyDrawable == 0) {
+            glbDeleteDummyObjectsGLX();
+            glbUnloadOpenGLSO();
+            return GL_INVALID_OPERATION;
+        }
+
+        glbBeginXCall();
+        glbind_glXMakeCurrent(glbind_pDisplay, glbind_DummyDrawable, glbind_RC);
+        glbEndXCall();
+#endif
+    }
+
+    if (pAPI != NULL) {
+#if defined(GLBIND_WGL)
+        result = glbInitContextAPI(glbind_DC, glbind_RC, pAPI);
+#endif
+#if defined(GLBIND_GLX)
+        result = glbInitContextAPI(glbind_pDisplay, glbind_DummyDrawable, glbind_RC, pAPI);
+#endif
+        if (result == GL_NO_ERROR) {
+            if (g_glbInitCount == 0) {
                 result = glbBindAPI(pAPI);
             }
         }
@@ -686,11 +1075,11 @@ GLenum glbInit(GLBapi* pAPI, GLBconfig* pConfig)
         result = glbInitContextAPI(glbind_DC, glbind_RC, &tempAPI);
 #endif
 #if defined(GLBIND_GLX)
-        result = glbInitContextAPI(glbind_pDisplay, glbind_DummyWindow, glbind_RC, &tempAPI);
+        result = glbInitContextAPI(glbind_pDisplay, glbind_DummyDrawable, glbind_RC, &tempAPI);
 #endif
         if (result == GL_NO_ERROR) {
             if (g_glbInitCount == 0) {
-                result = glbBindAPI(pAPI);
+                result = glbBindAPI(&tempAPI);
             }
         }
     }
@@ -710,23 +1099,10 @@ GLenum glbInit(GLBapi* pAPI, GLBconfig* pConfig)
             }
 #endif
 #if defined(GLBIND_GLX)
-            if (glbind_RC) {
-                glbind_glXDestroyContext(glbind_pDisplay, glbind_RC);
-                glbind_RC = 0;
-            }
-            if (glbind_DummyWindow) {
-                glbind_XDestroyWindow(glbind_pDisplay, glbind_DummyWindow);
-                glbind_DummyWindow = 0;
-            }
-            if (glbind_pDisplay && glbind_OwnsDisplay) {
-                glbind_XCloseDisplay(glbind_pDisplay);
-                glbind_pDisplay    = 0;
-                glbind_OwnsDisplay = GL_FALSE;
-            }
+            glbDeleteDummyObjectsGLX();
 #endif
 
-            glb_dlclose(g_glbOpenGLSO);
-            g_glbOpenGLSO = NULL;
+            glbUnloadOpenGLSO();
         }
 
         return result;
@@ -736,6 +1112,130 @@ GLenum glbInit(GLBapi* pAPI, GLBconfig* pConfig)
     return GL_NO_ERROR;
 }
 
+static void glbInitAsyncWorker()
+{
+    g_glbAsyncResult = glbInit(&g_glbAsyncAPI, (g_glbAsyncHasConfig) ? &g_glbAsyncConfig : NULL);
+    if (g_glbAsyncResult == GL_NO_ERROR) {
+        /* A context can only be current on one thread at a time. It's released here so that glbInitWait() can make it current on the calling thread. */
+#if defined(GLBIND_WGL)
+        glbind_wglMakeCurrent(NULL, NULL);
+#endif
+#if defined(GLBIND_GLX)
+        glbind_glXMakeCurrent(glbind_pDisplay, None, NULL);
+#endif
+    }
+}
+
+#if defined(GLBIND_WGL)
+static DWORD WINAPI glbInitAsyncThreadWin32(LPVOID pUserData)
+{
+    (void)pUserData;
+    glbInitAsyncWorker();
+    return 0;
+}
+#endif
+#if defined(GLBIND_GLX)
+static void* glbInitAsyncThreadPOSIX(void* pUserData)
+{
+    (void)pUserData;
+    glbInitAsyncWorker();
+    return NULL;
+}
+#endif
+
+GLenum glbInitAsync(GLBconfig* pConfig)
+{
+    if (g_glbAsyncPending) {
+        return GL_INVALID_OPERATION;
+    }
+
+    g_glbAsyncHasConfig = GL_FALSE;
+    if (pConfig != NULL) {
+        g_glbAsyncConfig    = *pConfig;
+        g_glbAsyncHasConfig = GL_TRUE;
+    }
+
+    g_glbAsyncPending  = GL_TRUE;
+    g_glbAsyncThreaded = GL_FALSE;
+
+    /*
+    Once initialized, the internal rendering context may be current on the calling thread which means it can't be used on another thread. There's
+    also nothing expensive left to do in this case since the libraries are already loaded.
+    */
+    if (g_glbInitCount == 0) {
+#if defined(GLBIND_WGL)
+        /* A window is destroyed when the thread that created it exits so it needs to be created here rather than on the background thread. */
+        g_glbAsyncDummyHWND = glbCreateDummyWindowWin32();
+        glbind_DummyHWND    = g_glbAsyncDummyHWND;
+        if (glbind_DummyHWND != 0) {
+            g_glbAsyncThread = CreateThread(NULL, 0, glbInitAsyncThreadWin32, NULL, 0, NULL);
+            if (g_glbAsyncThread != NULL) {
+                g_glbAsyncThreaded = GL_TRUE;
+            }
+        }
+#endif
+#if defined(GLBIND_GLX)
+        if (pthread_create(&g_glbAsyncThread, NULL, glbInitAsyncThreadPOSIX, NULL) == 0) {
+            g_glbAsyncThreaded = GL_TRUE;
+        }
+#endif
+    }
+
+    if (!g_glbAsyncThreaded) {
+        g_glbAsyncResult = glbInit(&g_glbAsyncAPI, (g_glbAsyncHasConfig) ? &g_glbAsyncConfig : NULL);
+    }
+
+    return GL_NO_ERROR;
+}
+
+GLenum glbInitWait(GLBapi* pAPI)
+{
+    if (!g_glbAsyncPending) {
+        return GL_INVALID_OPERATION;
+    }
+
+    if (g_glbAsyncThreaded) {
+#if defined(GLBIND_WGL)
+        WaitForSingleObject(g_glbAsyncThread, INFINITE);
+        CloseHandle(g_glbAsyncThread);
+#endif
+#if defined(GLBIND_GLX)
+        pthread_join(g_glbAsyncThread, NULL);
+#endif
+    }
+
+    g_glbAsyncPending = GL_FALSE;
+
+#if defined(GLBIND_WGL)
+    /* The background thread can't destroy a window that was created on this thread so it needs to be done here if initialization failed. */
+    if (g_glbAsyncResult != GL_NO_ERROR && g_glbAsyncDummyHWND) {
+        DestroyWindow(g_glbAsyncDummyHWND);
+        glbind_DummyHWND = 0;
+        glbind_DC   = 0;
+    }
+    g_glbAsyncDummyHWND = 0;
+#endif
+
+    if (g_glbAsyncResult != GL_NO_ERROR) {
+        return g_glbAsyncResult;
+    }
+
+    if (g_glbAsyncThreaded) {
+#if defined(GLBIND_WGL)
+        glbind_wglMakeCurrent(glbind_DC, glbind_RC);
+#endif
+#if defined(GLBIND_GLX)
+        glbind_glXMakeCurrent(glbind_pDisplay, glbind_DummyDrawable, glbind_RC);
+#endif
+    }
+
+    if (pAPI != NULL) {
+        *pAPI = g_glbAsyncAPI;
+    }
+
+    return GL_NO_ERROR;
+}
+
 #if defined(GLBIND_WGL)
 GLenum glbInitContextAPI(HDC dc, HGLRC rc, GLBapi* pAPI)
 {
@@ -773,6 +1273,11 @@ GLenum glbInitContextAPI(Display *dpy, GLXDrawable drawable, GLXContext rc, GLBa
         dpyPrev      = glbind_glXGetCurrentDisplay();
     }
 
+    /* Making a context current can be a round trip to the X server, so it's skipped when it's already current. */
+    if (dpyPrev == dpy && drawablePrev == drawable && rcPrev == rc) {
+        return glbInitCurrentContextAPI(pAPI);
+    }
+
     glbind_glXMakeCurrent(dpy, drawable, rc);
     result = glbInitCurrentContextAPI(pAPI);
     glbind_glXMakeCurrent(dpyPrev, drawablePrev, rcPrev);
@@ -781,6 +1286,531 @@ GLenum glbInitContextAPI(Display *dpy, GLXDrawable drawable, GLXContext rc, GLBa
 }
 #endif
 
+/* The definitions of the global function pointers declared in the header. */
+/*<<opengl_funcpointers_def_global>>*/
+
+/*
+The names of every command are packed into a single block of memory and referenced by a 32-bit offset. The offsets are in the same
+order as the members of GLBapi. This is used for loading everything in a single loop rather than having a separate call site, and
+string literal, for each function pointer.
+*/
+/*<<command_names>>*/
+
+#define GLBIND_COMMAND_COUNT    (sizeof(glbind_CommandNameOffsets) / sizeof(glbind_CommandNameOffsets[0]))
+
+/*
+glbGetProcFromAPI() maps a name to its member of GLBapi with a minimal perfect hash which is generated along with the rest of this file.
+The first hash of the name selects a bucket. A negative bucket value is the index of the entry, minus one. Otherwise it's the seed of a
+second hash which gives the index of the entry. No two names share an entry. The entry refers to a run of commands with the same
+condition rather than a member of GLBapi since the members depend on which runs have been compiled in. The size of each run is only
+added when its condition is met, which gives the index of the first member of each run in glbind_CommandRunSlots.
+*/
+typedef struct
+{
+    khronos_uint32_t nameOffset;
+    khronos_uint16_t run;
+    khronos_uint16_t index;     /* The index of the command within the run. */
+} glbind_CommandHashEntry;
+
+/*<<command_hash>>*/
+
+static khronos_uint32_t glbind_HashCommandName(const char* name, khronos_uint32_t seed)
+{
+    /* FNV-1a followed by the MurmurHash3 finalizer. This must match glbHashCommandName() in the build tool. */
+    khronos_uint32_t hash = (khronos_uint32_t)2166136261UL ^ seed;
+    while (*name) {
+        hash = (khronos_uint32_t)((hash ^ (unsigned char)*name) * 16777619UL);
+        name += 1;
+    }
+
+    hash ^= hash >> 16;
+    hash  = (khronos_uint32_t)(hash * 0x85EBCA6BUL);
+    hash ^= hash >> 13;
+    hash  = (khronos_uint32_t)(hash * 0xC2B2AE35UL);
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+/* GLBapi must be nothing but function pointers in the same order as glbind_CommandNameOffsets. */
+typedef char glbind_CommandCountCheck[(sizeof(GLBapi) == GLBIND_COMMAND_COUNT*sizeof(GLBproc)) ? 1 : -1];
+
+static void glbResolveCommands(GLBapi* pAPI, size_t iFirstCommand, size_t iEndCommand)
+{
+    size_t iCommand;
+    for (iCommand = iFirstCommand; iCommand < iEndCommand; ++iCommand) {
+        GLBproc proc = glbGetProcAddress((const char*)&glbind_CommandNamePool + glbind_CommandNameOffsets[iCommand]);
+        glbCopyMemory((GLbyte*)pAPI + (iCommand * sizeof(GLBproc)), &proc, sizeof(proc));
+    }
+}
+
+#if defined(GLBIND_GLX)
+#define GLBIND_MAX_RESOLVE_THREADS  32
+
+typedef struct
+{
+    GLBapi* pAPI;
+    size_t iFirstCommand;
+    size_t iEndCommand;
+} glbind_ResolveRange;
+
+static void* glbResolveCommandsThreadPOSIX(void* pUserData)
+{
+    glbind_ResolveRange* pRange = (glbind_ResolveRange*)pUserData;
+    glbResolveCommands(pRange->pAPI, pRange->iFirstCommand, pRange->iEndCommand);
+    return NULL;
+}
+
+/*
+glXGetProcAddress() doesn't depend on the current context so the commands can be split between threads. Each thread fills its own range
+of pAPI. The calling thread does the first range, and any range whose thread couldn't be started.
+*/
+static void glbResolveCommandsParallel(GLBapi* pAPI, GLuint threadCount)
+{
+    pthread_t threads[GLBIND_MAX_RESOLVE_THREADS];
+    GLboolean isThreadStarted[GLBIND_MAX_RESOLVE_THREADS];
+    glbind_ResolveRange ranges[GLBIND_MAX_RESOLVE_THREADS];
+    GLuint iThread;
+
+    if (threadCount > GLBIND_MAX_RESOLVE_THREADS) {
+        threadCount = GLBIND_MAX_RESOLVE_THREADS;
+    }
+
+    for (iThread = 0; iThread < threadCount; ++iThread) {
+        ranges[iThread].pAPI          = pAPI;
+        ranges[iThread].iFirstCommand = (GLBIND_COMMAND_COUNT *  iThread     ) / threadCount;
+        ranges[iThread].iEndCommand   = (GLBIND_COMMAND_COUNT * (iThread + 1)) / threadCount;
+    }
+
+    for (iThread = 1; iThread < threadCount; ++iThread) {
+        isThreadStarted[iThread] = pthread_create(&threads[iThread], NULL, glbResolveCommandsThreadPOSIX, &ranges[iThread]) == 0;
+    }
+
+    glbResolveCommands(pAPI, ranges[0].iFirstCommand, ranges[0].iEndCommand);
+
+    for (iThread = 1; iThread < threadCount; ++iThread) {
+        if (isThreadStarted[iThread]) {
+            pthread_join(threads[iThread], NULL);
+        } else {
+            glbResolveCommands(pAPI, ranges[iThread].iFirstCommand, ranges[iThread].iEndCommand);
+        }
+    }
+}
+
+/*
+The resolution cache stores where each function pointer is relative to the library it's in. Libraries are loaded at a different address
+each run, but a function stays at the same offset from the start of its library until the driver is updated. On the next run, only one
+function per library is retrieved by name to find where the library is, and everything else is that plus its offset.
+
+The cache is keyed on the vendor, renderer and version strings of the context, the set of commands compiled into glbind, and the inode,
+size and modification time of each library. The first function retrieved from each library must also come from the same library at the
+same offset as before. If anything doesn't match, or the file is damaged, the cache is ignored and rewritten.
+
+dladdr() is retrieved at run time since it's a GNU extension and needs _GNU_SOURCE, which would need to be defined before any system
+header is included. The layout of Dl_info is the same everywhere dladdr() exists.
+*/
+#define GLBIND_RESOLVE_CACHE_MAGIC          0x43524C47  /* "GLRC" */
+#define GLBIND_RESOLVE_CACHE_VERSION        1
+#define GLBIND_RESOLVE_CACHE_MAX_LIBRARIES  16
+#define GLBIND_RESOLVE_CACHE_MAX_KEY        1024        /* The maximum combined size of the vendor, renderer and version strings. */
+#define GLBIND_RESOLVE_CACHE_MAX_PATH       1024
+#define GLBIND_RESOLVE_CACHE_NOT_FOUND      0xFFFFFFFF  /* The driver returned NULL. */
+#define GLBIND_RESOLVE_CACHE_NO_LIBRARY     0xFFFFFFFE  /* Not in a library, such as a stub generated at run time. Retrieved by name. */
+
+typedef struct
+{
+    const char* dli_fname;
+    void* dli_fbase;
+    const char* dli_sname;
+    void* dli_saddr;
+} glbind_DlInfo;
+
+typedef int (* GLB_PFNDLADDRPROC)(const void* pAddress, glbind_DlInfo* pInfo);
+
+typedef struct
+{
+    khronos_uint32_t magic;
+    khronos_uint32_t version;
+    khronos_uint32_t pointerSize;
+    khronos_uint32_t commandCount;
+    khronos_uint32_t commandSetHash;
+    khronos_uint32_t libraryCount;
+    khronos_uint32_t keySize;           /* The vendor, renderer and version strings, each null terminated, follow the header. */
+    khronos_uint32_t checksum;          /* A hash of everything after the header. */
+} glbind_ResolveCacheHeader;
+
+typedef struct
+{
+    khronos_uint64_t inode;
+    khronos_uint64_t size;
+    khronos_int64_t  modifiedTime;
+    khronos_uint64_t anchorOffset;      /* The offset of the first command retrieved from this library. */
+    khronos_uint32_t anchorCommand;
+    khronos_uint32_t pathSize;          /* Including the null terminator. The path follows the library. */
+} glbind_ResolveCacheLibrary;
+
+typedef struct
+{
+    khronos_uint32_t library;           /* An index into the libraries, GLBIND_RESOLVE_CACHE_NOT_FOUND or GLBIND_RESOLVE_CACHE_NO_LIBRARY. */
+    khronos_uint32_t reserved;
+    khronos_uint64_t offset;
+} glbind_ResolveCacheEntry;
+
+static GLB_PFNDLADDRPROC glbGetDladdr()
+{
+    static GLB_PFNDLADDRPROC dladdrProc = NULL;
+    if (dladdrProc == NULL) {
+        GLBhandle handle = glb_dlopen(NULL);
+        if (handle != NULL) {
+            /* The handle of the main program only adds a reference, so closing it doesn't unload dladdr(). */
+            dladdrProc = (GLB_PFNDLADDRPROC)glb_dlsym(handle, "dladdr");
+            glb_dlclose(handle);
+        }
+    }
+
+    return dladdrProc;
+}
+
+static khronos_uint32_t glbind_HashBytes(const void* pData, size_t sz, khronos_uint32_t hash)
+{
+    size_t i;
+    for (i = 0; i < sz; ++i) {
+        hash = (khronos_uint32_t)((hash ^ ((const unsigned char*)pData)[i]) * 16777619UL);
+    }
+
+    return hash;
+}
+
+static GLBproc glbGetProcFromSlot(const GLBapi* pAPI, size_t iCommand)
+{
+    GLBproc proc;
+    glbCopyMemory(&proc, (const GLbyte*)pAPI + (iCommand * sizeof(GLBproc)), sizeof(proc));
+    return proc;
+}
+
+static void glbSetProcInSlot(GLBapi* pAPI, size_t iCommand, GLBproc proc)
+{
+    glbCopyMemory((GLbyte*)pAPI + (iCommand * sizeof(GLBproc)), &proc, sizeof(proc));
+}
+
+/* Retrieves the vendor, renderer and version strings of the current context, one after the other. Returns the size, or 0 if they don't fit. */
+static size_t glbGetResolveCacheKey(char* pKey, size_t keyCap)
+{
+    static const GLenum names[3] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+    PFNGLGETSTRINGPROC _glGetString = (PFNGLGETSTRINGPROC)glbGetProcAddress("glGetString");
+    size_t keySize = 0;
+    size_t iName;
+
+    if (_glGetString == NULL) {
+        return 0;
+    }
+
+    for (iName = 0; iName < 3; ++iName) {
+        const char* str = (const char*)_glGetString(names[iName]);
+        if (str == NULL) {
+            return 0;
+        }
+
+        do {
+            if (keySize == keyCap) {
+                return 0;
+            }
+            pKey[keySize++] = *str;
+        } while (*str++ != '\0');
+    }
+
+    return keySize;
+}
+
+static khronos_uint32_t glbGetCommandSetHash()
+{
+    khronos_uint32_t hash = (khronos_uint32_t)2166136261UL;
+    hash = glbind_HashBytes(&glbind_CommandNamePool, sizeof(glbind_CommandNamePool), hash);
+    hash = glbind_HashBytes(glbind_CommandNameOffsets, sizeof(glbind_CommandNameOffsets), hash);
+    return hash;
+}
+
+static GLboolean glbIsLibraryFileUnchanged(const char* path, const glbind_ResolveCacheLibrary* pLibrary)
+{
+    struct stat info;
+    if (stat(path, &info) != 0) {
+        return GL_FALSE;
+    }
+
+    return (khronos_uint64_t)info.st_ino   == pLibrary->inode &&
+           (khronos_uint64_t)info.st_size  == pLibrary->size  &&
+           (khronos_int64_t) info.st_mtime == pLibrary->modifiedTime;
+}
+
+static GLenum glbLoadResolveCache(const char* cachePath, GLBapi* pAPI)
+{
+    GLB_PFNDLADDRPROC _dladdr = glbGetDladdr();
+    glbind_ResolveCacheHeader header;
+    glbind_ResolveCacheLibrary library;
+    glbind_ResolveCacheEntry entry;
+    char key[GLBIND_RESOLVE_CACHE_MAX_KEY];
+    char cachedKey[GLBIND_RESOLVE_CACHE_MAX_KEY];
+    char path[GLBIND_RESOLVE_CACHE_MAX_PATH];
+    khronos_uintptr_t bases[GLBIND_RESOLVE_CACHE_MAX_LIBRARIES];
+    size_t keySize;
+    size_t iLibrary;
+    size_t iCommand;
+    size_t iPass;
+    long entriesPos;
+    khronos_uint32_t checksum = (khronos_uint32_t)2166136261UL;
+    FILE* pFile;
+
+    if (_dladdr == NULL) {
+        return GL_INVALID_OPERATION;
+    }
+
+    keySize = glbGetResolveCacheKey(key, sizeof(key));
+    if (keySize == 0) {
+        return GL_INVALID_OPERATION;
+    }
+
+    pFile = fopen(cachePath, "rb");
+    if (pFile == NULL) {
+        return GL_INVALID_OPERATION;
+    }
+
+    if (fread(&header, sizeof(header), 1, pFile) != 1 ||
+        header.magic          != GLBIND_RESOLVE_CACHE_MAGIC   ||
+        header.version        != GLBIND_RESOLVE_CACHE_VERSION ||
+        header.pointerSize    != sizeof(GLBproc)              ||
+        header.commandCount   != GLBIND_COMMAND_COUNT         ||
+        header.commandSetHash != glbGetCommandSetHash()       ||
+        header.libraryCount   >  GLBIND_RESOLVE_CACHE_MAX_LIBRARIES ||
+        header.keySize        != keySize) {
+        fclose(pFile);
+        return GL_INVALID_OPERATION;
+    }
+
+    if (fread(cachedKey, keySize, 1, pFile) != 1 || glbCompareMemory(cachedKey, key, keySize) != 0) {
+        fclose(pFile);
+        return GL_INVALID_OPERATION;
+    }
+    checksum = glbind_HashBytes(cachedKey, keySize, checksum);
+
+    /* Each library is found by retrieving its first command by name, which must still be in the same library at the same offset. */
+    for (iLibrary = 0; iLibrary < header.libraryCount; ++iLibrary) {
+        glbind_DlInfo info;
+        GLBproc anchor;
+
+        if (fread(&library, sizeof(library), 1, pFile) != 1 || library.pathSize == 0 || library.pathSize > sizeof(path) || library.anchorCommand >= GLBIND_COMMAND_COUNT ||
+            fread(path, library.pathSize, 1, pFile) != 1 || path[library.pathSize-1] != '\0') {
+            fclose(pFile);
+            return GL_INVALID_OPERATION;
+        }
+        checksum = glbind_HashBytes(&library, sizeof(library), checksum);
+        checksum = glbind_HashBytes(path, library.pathSize, checksum);
+
+        if (!glbIsLibraryFileUnchanged(path, &library)) {
+            fclose(pFile);
+            return GL_INVALID_OPERATION;
+        }
+
+        anchor = glbGetProcAddress((const char*)&glbind_CommandNamePool + glbind_CommandNameOffsets[library.anchorCommand]);
+        if (anchor == NULL || _dladdr((const void*)(khronos_uintptr_t)anchor, &info) == 0 || info.dli_fname == NULL || glb_strcmp(info.dli_fname, path) != 0 ||
+            (khronos_uintptr_t)anchor - (khronos_uintptr_t)info.dli_fbase != library.anchorOffset) {
+            fclose(pFile);
+            return GL_INVALID_OPERATION;
+        }
+
+        bases[iLibrary] = (khronos_uintptr_t)info.dli_fbase;
+    }
+
+    /*
+    Nothing is written to the API until the whole file has been validated, including the checksum, so the entries are read twice rather
+    than being held in memory. The first pass only validates them. If the file is replaced between the two passes, the checksum of the
+    second pass won't match and the slots are cleared again.
+    */
+    entriesPos = ftell(pFile);
+    if (entriesPos < 0) {
+        fclose(pFile);
+        return GL_INVALID_OPERATION;
+    }
+
+    for (iPass = 0; iPass < 2; ++iPass) {
+        GLboolean isValid = (iPass == 0 || fseek(pFile, entriesPos, SEEK_SET) == 0);
+        khronos_uint32_t entriesChecksum = checksum;
+
+        for (iCommand = 0; iCommand < GLBIND_COMMAND_COUNT && isValid; ++iCommand) {
+            GLBproc proc;
+
+            if (fread(&entry, sizeof(entry), 1, pFile) != 1 ||
+                (entry.library != GLBIND_RESOLVE_CACHE_NOT_FOUND && entry.library != GLBIND_RESOLVE_CACHE_NO_LIBRARY && entry.library >= header.libraryCount)) {
+                isValid = GL_FALSE;
+                break;
+            }
+            entriesChecksum = glbind_HashBytes(&entry, sizeof(entry), entriesChecksum);
+
+            if (iPass == 0) {
+                continue;
+            }
+
+            if (entry.library == GLBIND_RESOLVE_CACHE_NOT_FOUND) {
+                proc = NULL;
+            } else if (entry.library == GLBIND_RESOLVE_CACHE_NO_LIBRARY) {
+                proc = glbGetProcAddress((const char*)&glbind_CommandNamePool + glbind_CommandNameOffsets[iCommand]);
+            } else {
+                proc = (GLBproc)(bases[entry.library] + (khronos_uintptr_t)entry.offset);
+            }
+
+            glbSetProcInSlot(pAPI, iCommand, proc);
+        }
+
+        if (!isValid || entriesChecksum != header.checksum) {
+            fclose(pFile);
+            if (iPass == 1) {
+                glbZeroObject(pAPI);
+            }
+            return GL_INVALID_OPERATION;
+        }
+    }
+
+    fclose(pFile);
+
+    return GL_NO_ERROR;
+}
+
+static void glbSaveResolveCache(const char* cachePath, const GLBapi* pAPI)
+{
+    GLB_PFNDLADDRPROC _dladdr = glbGetDladdr();
+    glbind_ResolveCacheHeader header;
+    glbind_ResolveCacheLibrary libraries[GLBIND_RESOLVE_CACHE_MAX_LIBRARIES];
+    const char* libraryPaths[GLBIND_RESOLVE_CACHE_MAX_LIBRARIES];
+    khronos_uintptr_t libraryBases[GLBIND_RESOLVE_CACHE_MAX_LIBRARIES];
+    char key[GLBIND_RESOLVE_CACHE_MAX_KEY];
+    char tempPath[GLBIND_RESOLVE_CACHE_MAX_PATH + 32];
+    size_t keySize;
+    size_t cachePathSize;
+    size_t iLibrary;
+    size_t iCommand;
+    int isWritten;
+    FILE* pFile;
+
+    if (_dladdr == NULL) {
+        return;
+    }
+
+    cachePathSize = 0;
+    while (cachePath[cachePathSize] != '\0') {
+        cachePathSize += 1;
+    }
+    if (cachePathSize >= GLBIND_RESOLVE_CACHE_MAX_PATH) {
+        return;
+    }
+
+    keySize = glbGetResolveCacheKey(key, sizeof(key));
+    if (keySize == 0) {
+        return;
+    }
+
+    glbZeroObject(&header);
+    header.magic          = GLBIND_RESOLVE_CACHE_MAGIC;
+    header.version        = GLBIND_RESOLVE_CACHE_VERSION;
+    header.pointerSize    = sizeof(GLBproc);
+    header.commandCount   = GLBIND_COMMAND_COUNT;
+    header.commandSetHash = glbGetCommandSetHash();
+    header.keySize        = (khronos_uint32_t)keySize;
+
+    /* The first pass finds the libraries so they can be written before the entries. */
+    for (iCommand = 0; iCommand < GLBIND_COMMAND_COUNT; ++iCommand) {
+        GLBproc proc = glbGetProcFromSlot(pAPI, iCommand);
+        glbind_DlInfo info;
+        struct stat fileInfo;
+        size_t pathSize;
+
+        if (proc == NULL || _dladdr((const void*)(khronos_uintptr_t)proc, &info) == 0 || info.dli_fname == NULL || info.dli_fname[0] == '\0') {
+            continue;
+        }
+
+        for (iLibrary = 0; iLibrary < header.libraryCount; ++iLibrary) {
+            if (glb_strcmp(libraryPaths[iLibrary], info.dli_fname) == 0) {
+                break;
+            }
+        }
+
+        pathSize = 0;
+        while (info.dli_fname[pathSize++] != '\0') {
+        }
+
+        if (iLibrary < header.libraryCount || header.libraryCount == GLBIND_RESOLVE_CACHE_MAX_LIBRARIES || pathSize > GLBIND_RESOLVE_CACHE_MAX_PATH ||
+            stat(info.dli_fname, &fileInfo) != 0) {
+            continue;
+        }
+
+        libraries[iLibrary].inode         = (khronos_uint64_t)fileInfo.st_ino;
+        libraries[iLibrary].size          = (khronos_uint64_t)fileInfo.st_size;
+        libraries[iLibrary].modifiedTime  = (khronos_int64_t) fileInfo.st_mtime;
+        libraries[iLibrary].anchorOffset  = (khronos_uint64_t)((khronos_uintptr_t)proc - (khronos_uintptr_t)info.dli_fbase);
+        libraries[iLibrary].anchorCommand = (khronos_uint32_t)iCommand;
+        libraries[iLibrary].pathSize      = (khronos_uint32_t)pathSize;
+        libraryPaths[iLibrary] = info.dli_fname;
+        libraryBases[iLibrary] = (khronos_uintptr_t)info.dli_fbase;
+        header.libraryCount += 1;
+    }
+
+    /*
+    The cache is written to a temporary file which then replaces the old one. Another process loading the cache at the same time sees
+    either the old file or the new one, never a partial write. The process ID keeps processes saving at the same time apart.
+    */
+    sprintf(tempPath, "%s.%lu.tmp", cachePath, (unsigned long)getpid());
+
+    pFile = fopen(tempPath, "wb");
+    if (pFile == NULL) {
+        return;
+    }
+
+    /* The header is written again at the end once the checksum is known. */
+    header.checksum = (khronos_uint32_t)2166136261UL;
+    fwrite(&header, sizeof(header), 1, pFile);
+
+    fwrite(key, keySize, 1, pFile);
+    header.checksum = glbind_HashBytes(key, keySize, header.checksum);
+
+    for (iLibrary = 0; iLibrary < header.libraryCount; ++iLibrary) {
+        fwrite(&libraries[iLibrary], sizeof(libraries[iLibrary]), 1, pFile);
+        fwrite(libraryPaths[iLibrary], libraries[iLibrary].pathSize, 1, pFile);
+        header.checksum = glbind_HashBytes(&libraries[iLibrary], sizeof(libraries[iLibrary]), header.checksum);
+        header.checksum = glbind_HashBytes(libraryPaths[iLibrary], libraries[iLibrary].pathSize, header.checksum);
+    }
+
+    for (iCommand = 0; iCommand < GLBIND_COMMAND_COUNT; ++iCommand) {
+        GLBproc proc = glbGetProcFromSlot(pAPI, iCommand);
+        glbind_ResolveCacheEntry entry;
+        glbind_DlInfo info;
+
+        glbZeroObject(&entry);
+        entry.library = GLBIND_RESOLVE_CACHE_NO_LIBRARY;
+
+        if (proc == NULL) {
+            entry.library = GLBIND_RESOLVE_CACHE_NOT_FOUND;
+        } else if (_dladdr((const void*)(khronos_uintptr_t)proc, &info) != 0 && info.dli_fname != NULL) {
+            for (iLibrary = 0; iLibrary < header.libraryCount; ++iLibrary) {
+                if (libraryBases[iLibrary] == (khronos_uintptr_t)info.dli_fbase && glb_strcmp(libraryPaths[iLibrary], info.dli_fname) == 0) {
+                    entry.library = (khronos_uint32_t)iLibrary;
+                    entry.offset  = (khronos_uint64_t)((khronos_uintptr_t)proc - libraryBases[iLibrary]);
+                    break;
+                }
+            }
+        }
+
+        fwrite(&entry, sizeof(entry), 1, pFile);
+        header.checksum = glbind_HashBytes(&entry, sizeof(entry), header.checksum);
+    }
+
+    fseek(pFile, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, pFile);
+
+    isWritten = (ferror(pFile) == 0);
+    if (fclose(pFile) != 0 || !isWritten || rename(tempPath, cachePath) != 0) {
+        remove(tempPath);
+    }
+}
+#endif
+
 GLenum glbInitCurrentContextAPI(GLBapi* pAPI)
 {
     if (pAPI == NULL) {
@@ -789,7 +1819,23 @@ GLenum glbInitCurrentContextAPI(GLBapi* pAPI)
 
     glbZeroObject(pAPI);
 
-/*<<init_current_context_api>>*/
+#if defined(GLBIND_GLX)
+    if (g_glbResolveCachePath != NULL && glbLoadResolveCache(g_glbResolveCachePath, pAPI) == GL_NO_ERROR) {
+        return GL_NO_ERROR;
+    }
+
+    if (g_glbResolveThreadCount > 1) {
+        glbResolveCommandsParallel(pAPI, g_glbResolveThreadCount);
+    } else {
+        glbResolveCommands(pAPI, 0, GLBIND_COMMAND_COUNT);
+    }
+
+    if (g_glbResolveCachePath != NULL) {
+        glbSaveResolveCache(g_glbResolveCachePath, pAPI);
+    }
+#else
+    glbResolveCommands(pAPI, 0, GLBIND_COMMAND_COUNT);
+#endif
 
     return GL_NO_ERROR;
 }
@@ -814,23 +1860,10 @@ void glbUninit()
         }
 #endif
 #if defined(GLBIND_GLX)
-        if (glbind_RC) {
-            glbind_glXDestroyContext(glbind_pDisplay, glbind_RC);
-            glbind_RC = 0;
-        }
-        if (glbind_DummyWindow) {
-            glbind_XDestroyWindow(glbind_pDisplay, glbind_DummyWindow);
-            glbind_DummyWindow = 0;
-        }
-        if (glbind_pDisplay && glbind_OwnsDisplay) {
-            glbind_XCloseDisplay(glbind_pDisplay);
-            glbind_pDisplay    = 0;
-            glbind_OwnsDisplay = GL_FALSE;
-        }
+        glbDeleteDummyObjectsGLX();
 #endif
 
-        glb_dlclose(g_glbOpenGLSO);
-        g_glbOpenGLSO = NULL;
+        glbUnloadOpenGLSO();
     }
 }
 
@@ -844,7 +1877,7 @@ GLenum glbBindAPI(const GLBapi* pAPI)
         result = glbInitContextAPI(glbind_DC, glbind_RC, &tempAPI);
 #endif
 #if defined(GLBIND_GLX)
-        result = glbInitContextAPI(glbind_pDisplay, glbind_DummyWindow, glbind_RC, &tempAPI);
+        result = glbInitContextAPI(glbind_pDisplay, glbind_DummyDrawable, glbind_RC, &tempAPI);
 #endif
         if (result != GL_NO_ERROR) {
             return result;
@@ -858,6 +1891,11 @@ GLenum glbBindAPI(const GLBapi* pAPI)
     return GL_NO_ERROR;
 }
 
+GLBinitStats glbGetInitStats()
+{
+    return g_glbInitStats;
+}
+
 #if defined(GLBIND_WGL)
 HGLRC glbGetRC()
 {
@@ -886,41 +1924,181 @@ GLXContext glbGetRC()
     return glbind_RC;
 }
 
+GLXFBConfig glbGetFBConfig()
+{
+    return glbind_FBConfig;
+}
+
 Colormap glbGetColormap()
 {
+    if (glbind_Colormap == 0 && glbGetFBVisualInfo() != NULL) {
+        glbind_Colormap = glbind_XCreateColormap(glbind_pDisplay, RootWindow(glbind_pDisplay, glbind_pFBVisualInfo->screen), glbind_pFBVisualInfo->visual, AllocNone);
+    }
+
     return glbind_Colormap;
 }
 
 XVisualInfo* glbGetFBVisualInfo()
 {
+    if (glbind_pFBVisualInfo == NULL && glbind_FBConfig != NULL) {
+        glbind_pFBVisualInfo = glbind_glXGetVisualFromFBConfig(glbind_pDisplay, glbind_FBConfig);
+    }
+
     return glbind_pFBVisualInfo;
 }
 #endif
 
-
-int glb_strcmp(const char* s1, const char* s2)
+GLBproc glbGetProcFromAPI(const GLBapi* pAPI, const char* name)
 {
-    while ((*s1) && (*s1 == *s2)) {
-        ++s1;
-        ++s2;
+    khronos_int32_t bucket;
+    const glbind_CommandHashEntry* pEntry;
+    size_t slot;
+    GLBproc proc;
+
+    if (pAPI == NULL || name == NULL) {
+        return NULL;
     }
 
-    return (*(unsigned char*)s1 - *(unsigned char*)s2);
+    bucket = glbind_CommandHashBuckets[glbind_HashCommandName(name, 0) % GLBIND_COMMAND_HASH_BUCKET_COUNT];
+    if (bucket < 0) {
+        pEntry = &glbind_CommandHashEntries[-(bucket + 1)];
+    } else {
+        pEntry = &glbind_CommandHashEntries[glbind_HashCommandName(name, (khronos_uint32_t)bucket) % GLBIND_COMMAND_HASH_ENTRY_COUNT];
+    }
+
+    if (glb_strcmp(name, (const char*)&glbind_CommandNamePool + pEntry->nameOffset) != 0) {
+        return NULL;
+    }
+
+    /* An empty run has been excluded at compile time. */
+    if (glbind_CommandRunSlots[pEntry->run] == glbind_CommandRunSlots[pEntry->run + 1]) {
+        return NULL;
+    }
+
+    slot = glbind_CommandRunSlots[pEntry->run] + pEntry->index;
+    glbCopyMemory(&proc, (const GLbyte*)pAPI + (slot * sizeof(GLBproc)), sizeof(proc));
+
+    return proc;
 }
 
-int glb_strncmp(const char* s1, const char* s2, size_t n)
+/*
+Each member of GLBlimits has an entry in glbind_LimitQueries which is generated along with the rest of this file. The registry doesn't
+say which profile or version a context needs for each limit so that's taken from the feature that added it.
+*/
+#define GLBIND_LIMIT_INT                    0
+#define GLBIND_LIMIT_INT64                  1
+#define GLBIND_LIMIT_FLOAT                  2
+#define GLBIND_LIMIT_INDEXED_INT            3
+#define GLBIND_LIMIT_FLAG_COMPATIBILITY     1   /* Removed from the core profile. */
+
+/* The enums for the profile aren't available when GLBIND_MAX_GL_VERSION is below 3.2. */
+#define GLBIND_CONTEXT_PROFILE_MASK         0x9126
+#define GLBIND_CONTEXT_CORE_PROFILE_BIT     0x00000001
+
+typedef struct
 {
-    while (n && *s1 && (*s1 == *s2)) {
-        ++s1;
-        ++s2;
-        --n;
+    GLenum pname;
+    khronos_uint16_t offset;
+    khronos_uint8_t type;
+    khronos_uint8_t count;
+    khronos_uint8_t version;    /* The version of OpenGL that added the limit, times 10. */
+    khronos_uint8_t flags;
+} glbind_LimitQuery;
+
+/*<<limit_queries>>*/
+
+GLenum glbQueryLimits(const GLBapi* pAPI, GLBlimits* pLimits)
+{
+    PFNGLGETSTRINGPROC     _glGetString     = (pAPI != NULL) ? pAPI->glGetString     : glGetString;
+    PFNGLGETINTEGERVPROC   _glGetIntegerv   = (pAPI != NULL) ? pAPI->glGetIntegerv   : glGetIntegerv;
+    PFNGLGETFLOATVPROC     _glGetFloatv     = (pAPI != NULL) ? pAPI->glGetFloatv     : glGetFloatv;
+#if defined(GLBIND_HAS_GL_VERSION_3_0)
+    PFNGLGETINTEGERI_VPROC _glGetIntegeri_v = (pAPI != NULL) ? pAPI->glGetIntegeri_v : glGetIntegeri_v;
+#endif
+#if defined(GLBIND_HAS_GL_VERSION_3_2)
+    PFNGLGETINTEGER64VPROC _glGetInteger64v = (pAPI != NULL) ? pAPI->glGetInteger64v : glGetInteger64v;
+#endif
+    const char* versionStr;
+    GLint version;
+    GLboolean isCoreProfile = GL_FALSE;
+    const glbind_LimitQuery* pQuery;
+
+    if (pLimits == NULL) {
+        return GL_INVALID_VALUE;
     }
 
-    if (n == 0) {
-        return 0;
-    } else {
-        return (*(unsigned char*)s1 - *(unsigned char*)s2);
+    glbZeroObject(pLimits);
+
+    if (_glGetString == NULL || _glGetIntegerv == NULL || _glGetFloatv == NULL) {
+        return GL_INVALID_OPERATION;
+    }
+
+    versionStr = (const char*)_glGetString(GL_VERSION);
+    if (versionStr == NULL) {
+        return GL_INVALID_OPERATION;
+    }
+
+    /* OpenGL ES puts "OpenGL ES " in front of the version. */
+    while (*versionStr != '\0' && (*versionStr < '0' || *versionStr > '9')) {
+        versionStr += 1;
+    }
+    while (*versionStr >= '0' && *versionStr <= '9') {
+        pLimits->majorVersion = (pLimits->majorVersion * 10) + (*versionStr - '0');
+        versionStr += 1;
+    }
+    if (*versionStr == '.') {
+        versionStr += 1;
+        while (*versionStr >= '0' && *versionStr <= '9') {
+            pLimits->minorVersion = (pLimits->minorVersion * 10) + (*versionStr - '0');
+            versionStr += 1;
+        }
     }
+
+    version = (pLimits->majorVersion * 10) + pLimits->minorVersion;
+
+#if defined(GLBIND_LIMITS_HAVE_COMPATIBILITY)
+    if (version >= 32) {
+        GLint profileMask = 0;
+        _glGetIntegerv(GLBIND_CONTEXT_PROFILE_MASK, &profileMask);
+        isCoreProfile = (profileMask & GLBIND_CONTEXT_CORE_PROFILE_BIT) != 0;
+    }
+#endif
+
+    for (pQuery = glbind_LimitQueries; pQuery->pname != 0; ++pQuery) {
+        GLbyte* pValue = (GLbyte*)pLimits + pQuery->offset;
+
+        if (version < pQuery->version || (isCoreProfile && (pQuery->flags & GLBIND_LIMIT_FLAG_COMPATIBILITY) != 0)) {
+            continue;
+        }
+
+        if (pQuery->type == GLBIND_LIMIT_INT) {
+            _glGetIntegerv(pQuery->pname, (GLint*)pValue);
+        } else if (pQuery->type == GLBIND_LIMIT_FLOAT) {
+            _glGetFloatv(pQuery->pname, (GLfloat*)pValue);
+        } else if (pQuery->type == GLBIND_LIMIT_INT64) {
+            GLint value = 0;
+#if defined(GLBIND_HAS_GL_VERSION_3_2)
+            if (_glGetInteger64v != NULL && version >= 32) {
+                _glGetInteger64v(pQuery->pname, (GLint64*)pValue);
+                continue;
+            }
+#endif
+            /* Older versions only have 32-bit queries. */
+            _glGetIntegerv(pQuery->pname, &value);
+            *(khronos_int64_t*)pValue = value;
+        } else if (pQuery->type == GLBIND_LIMIT_INDEXED_INT) {
+#if defined(GLBIND_HAS_GL_VERSION_3_0)
+            GLuint index;
+            if (_glGetIntegeri_v != NULL) {
+                for (index = 0; index < pQuery->count; ++index) {
+                    _glGetIntegeri_v(pQuery->pname, index, (GLint*)pValue + index);
+                }
+            }
+#endif
+        }
+    }
+
+    return GL_NO_ERROR;
 }
 
 GLboolean glbIsExtensionInString(const char* ext, const char* str)
@@ -959,17 +2137,28 @@ GLboolean glbIsExtensionInString(const char* ext, const char* str)
 #if defined(GLBIND_WGL)
 GLboolean glbIsExtensionSupportedWGL(GLBapi* pAPI, const char* extensionName)
 {
+    /* The extension string extensions may have been excluded. */
+#if defined(GLBIND_HAS_WGL_ARB_extensions_string)
     PFNWGLGETEXTENSIONSSTRINGARBPROC _wglGetExtensionsStringARB = (pAPI != NULL) ? pAPI->wglGetExtensionsStringARB : wglGetExtensionsStringARB;
-    PFNWGLGETEXTENSIONSSTRINGEXTPROC _wglGetExtensionsStringEXT = (pAPI != NULL) ? pAPI->wglGetExtensionsStringEXT : wglGetExtensionsStringEXT;
     PFNWGLGETCURRENTDCPROC           _wglGetCurrentDC           = (pAPI != NULL) ? pAPI->wglGetCurrentDC           : glbind_wglGetCurrentDC;
+#endif
+#if defined(GLBIND_HAS_WGL_EXT_extensions_string)
+    PFNWGLGETEXTENSIONSSTRINGEXTPROC _wglGetExtensionsStringEXT = (pAPI != NULL) ? pAPI->wglGetExtensionsStringEXT : wglGetExtensionsStringEXT;
+#endif
 
+#if defined(GLBIND_HAS_WGL_ARB_extensions_string)
     if (_wglGetExtensionsStringARB) {
         return glbIsExtensionInString(extensionName, _wglGetExtensionsStringARB(_wglGetCurrentDC()));
     }
+#endif
+#if defined(GLBIND_HAS_WGL_EXT_extensions_string)
     if (_wglGetExtensionsStringEXT) {
         return glbIsExtensionInString(extensionName, _wglGetExtensionsStringEXT());
     }
+#endif
 
+    (void)pAPI;
+    (void)extensionName;
     return GL_FALSE;
 }
 #endif
@@ -990,10 +2179,13 @@ GLboolean glbIsExtensionSupportedGLX(GLBapi* pAPI, const char* extensionName)
 GLboolean glbIsExtensionSupported(GLBapi* pAPI, const char* extensionName)
 {
     GLboolean isSupported = GL_FALSE;
+#if defined(GLBIND_HAS_GL_VERSION_3_0)
     PFNGLGETSTRINGIPROC  _glGetStringi  = (pAPI != NULL) ? pAPI->glGetStringi  : glGetStringi;
+#endif
     PFNGLGETSTRINGPROC   _glGetString   = (pAPI != NULL) ? pAPI->glGetString   : glGetString;
     PFNGLGETINTEGERVPROC _glGetIntegerv = (pAPI != NULL) ? pAPI->glGetIntegerv : glGetIntegerv;
 
+#if defined(GLBIND_HAS_GL_VERSION_3_0)
     /* Try the new way first. */
     if (_glGetStringi && _glGetIntegerv) {
         GLint iExtension;
@@ -1019,6 +2211,9 @@ GLboolean glbIsExtensionSupported(GLBapi* pAPI, const char* extensionName)
 #endif
         return isSupported;
     }
+#else
+    (void)_glGetIntegerv;   /* glGetStringi() has been excluded. */
+#endif
 
     /* Fall back to old style. */
     if (_glGetString) {